@@ -0,0 +1,101 @@
+#include "./Benchmark.h"
+
+#include <algorithm>
+#include <format>
+#include <numeric>
+
+namespace bench {
+
+namespace {
+
+double percentile(std::vector<double> values, double ratio) {
+    if (values.empty())
+        return 0.0;
+
+    std::sort(values.begin(), values.end());
+    const auto index = std::min(values.size() - 1, std::size_t(ratio * (values.size() - 1) + 0.5));
+    return values[index];
+}
+
+} // namespace
+
+double Result::min() const {
+    return timings.empty() ? 0.0 : *std::min_element(timings.begin(), timings.end());
+}
+
+double Result::max() const {
+    return timings.empty() ? 0.0 : *std::max_element(timings.begin(), timings.end());
+}
+
+double Result::mean() const {
+    return timings.empty() ? 0.0 : std::accumulate(timings.begin(), timings.end(), 0.0) / timings.size();
+}
+
+double Result::median() const {
+    return percentile(timings, 0.5);
+}
+
+double Result::p95() const {
+    return percentile(timings, 0.95);
+}
+
+double Result::megapixelsPerSecond() const {
+    const auto ms = median();
+    return ms > 0.0 ? megapixels / (ms / 1000.0) : 0.0;
+}
+
+Report::Report(std::size_t iterations) : _iterations(iterations) {}
+
+std::size_t Report::getIterations() const {
+    return _iterations;
+}
+
+Result &Report::add(const std::string &scene, const std::map<std::string, std::size_t> &params, std::size_t elements, const std::string &stage) {
+    auto &result = _results.emplace_back();
+    result.scene = scene;
+    result.params = params;
+    result.elements = elements;
+    result.stage = stage;
+    result.timings.reserve(_iterations);
+    return result;
+}
+
+const std::vector<Result> &Report::getResults() const {
+    return _results;
+}
+
+std::string Report::toJson() const {
+    std::string json = std::format("{{\n  \"iterations\": {},\n  \"results\": [", _iterations);
+
+    for (std::size_t i = 0; i < _results.size(); ++i) {
+        const auto &result = _results[i];
+
+        std::string params;
+        for (const auto &[name, value] : result.params) {
+            if (!params.empty())
+                params += ", ";
+            params += std::format("\"{}\": {}", name, value);
+        }
+
+        std::string throughput;
+        if (result.megapixels > 0.0)
+            throughput = std::format(", \"mpixPerSecond\": {:.2f}", result.megapixelsPerSecond());
+        if (result.maxError)
+            throughput += std::format(", \"maxError\": {}", *result.maxError);
+
+        json += std::format(
+            "{}\n    {{\"scene\": \"{}\", \"params\": {{{}}}, \"elements\": {}, \"stage\": \"{}\", \"unit\": \"ms\", "
+            "\"min\": {:.4f}, \"median\": {:.4f}, \"mean\": {:.4f}, \"p95\": {:.4f}, \"max\": {:.4f}{}}}",
+            i == 0 ? "" : ",", result.scene, params, result.elements, result.stage,
+            result.min(), result.median(), result.mean(), result.p95(), result.max(), throughput);
+    }
+
+    json += "\n  ]\n}\n";
+    return json;
+}
+
+double ElapsedMs(Report::Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Report::Clock::now() - start).count();
+}
+
+} // namespace bench
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+struct Result {
+    std::string scene;
+    std::map<std::string, std::size_t> params;
+    std::size_t elements;
+    std::string stage;
+    std::vector<double> timings; // milliseconds, one per iteration
+    double megapixels = 0.0;     // produced per iteration, throughput is reported if set
+    std::optional<int> maxError; // largest channel difference with reference output
+
+    double min() const;
+    double max() const;
+    double mean() const;
+    double median() const;
+    double p95() const;
+    // From median timing
+    double megapixelsPerSecond() const;
+};
+
+/**
+ * Collects stage timings of every scene and serializes them as JSON :
+ * { "iterations": n, "results": [ { "scene", "params", "elements", "stage", "unit", "min", "median", "mean", "p95", "max", ["mpixPerSecond"], ["maxError"] } ] }
+ */
+class Report {
+    std::size_t _iterations;
+    std::vector<Result> _results;
+
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    Report(std::size_t iterations);
+
+    std::size_t getIterations() const;
+
+    Result &add(const std::string &scene, const std::map<std::string, std::size_t> &params, std::size_t elements, const std::string &stage);
+
+    const std::vector<Result> &getResults() const;
+
+    std::string toJson() const;
+};
+
+// Elapsed milliseconds since `start`
+double ElapsedMs(Report::Clock::time_point start);
+
+} // namespace bench
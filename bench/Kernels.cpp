@@ -0,0 +1,185 @@
+#include "./Kernels.h"
+
+#include <rendering/backend/Compositor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+
+namespace bench {
+
+namespace {
+
+using namespace ui::rendering::backend;
+
+struct Kernel {
+    std::string name;
+    // Resets `target` to kernel input, not timed
+    std::function<void(Surface &target)> prepare;
+    std::function<void(const SpanKernels &kernels, Surface &target)> run;
+    // Expected output computed in double precision then rounded, empty if none
+    std::function<std::vector<std::uint32_t>()> exact;
+};
+
+double channelOf(std::uint32_t pixel, int shift) {
+    return (pixel >> shift) & 0xff;
+}
+
+// Packs `channel(i, shift)` of every pixel, rounded and clamped
+std::vector<std::uint32_t> exactPixels(std::size_t count, const std::function<double(std::size_t i, int shift)> &channel) {
+    std::vector<std::uint32_t> pixels(count);
+    for (std::size_t i = 0; i < count; ++i)
+        for (int shift = 0; shift < 32; shift += 8)
+            pixels[i] |= std::uint32_t(std::lround(std::clamp(channel(i, shift), 0.0, 255.0))) << shift;
+    return pixels;
+}
+
+// `src` over `dst`, both premultiplied
+double exactOver(std::uint32_t src, std::uint32_t dst, int shift) {
+    return channelOf(src, shift) + channelOf(dst, shift) * (255.0 - channelOf(src, 24)) / 255.0;
+}
+
+// Sample of `src` at texel coordinate (x; y), texel centers being on integers and edges clamped
+double exactBilinear(const Surface &src, double x, double y, int shift) {
+    const auto x0 = std::floor(x), y0 = std::floor(y);
+    const auto fx = x - x0, fy = y - y0;
+    auto texel = [&](double tx, double ty) {
+        const auto column = std::clamp(int(tx), 0, src.width - 1), row = std::clamp(int(ty), 0, src.height - 1);
+        return channelOf(src.row(row)[column], shift);
+    };
+    return (texel(x0, y0) * (1 - fx) + texel(x0 + 1, y0) * fx) * (1 - fy) +
+           (texel(x0, y0 + 1) * (1 - fx) + texel(x0 + 1, y0 + 1) * fx) * fy;
+}
+
+std::vector<std::uint32_t> randomPixels(std::size_t count, std::uint32_t seed, bool premultiplied) {
+    std::minstd_rand random(seed);
+    std::vector<std::uint32_t> pixels(count);
+    for (auto &pixel : pixels)
+        pixel = random() ^ (random() << 16);
+
+    if (premultiplied)
+        SpanKernels::Scalar().premultiply(pixels.data(), pixels.size());
+    return pixels;
+}
+
+int maxChannelError(const std::vector<std::uint32_t> &a, const std::vector<std::uint32_t> &b) {
+    int error = 0;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        for (int shift = 0; shift < 32; shift += 8)
+            error = std::max(error, std::abs(int((a[i] >> shift) & 0xff) - int((b[i] >> shift) & 0xff)));
+    return error;
+}
+
+} // namespace
+
+bool RunKernels(Report &report, int width, int height) {
+    const auto count = std::size_t(width) * height;
+    const auto source = randomPixels(count, 1, true);
+    const auto destination = randomPixels(count, 2, true);
+    const auto straight = randomPixels(count, 3, false);
+
+    // layers are bottom-up render targets
+    Surface layer(width, height, true);
+    layer.pixels = source;
+    std::vector<std::uint32_t> scratch;
+
+    auto reset = [](const std::vector<std::uint32_t> &pixels) {
+        return [&pixels](Surface &target) { target.pixels = pixels; };
+    };
+
+    const auto fillColor = Compositor::Premultiply(Color{200, 100, 50, 128});
+    const auto opacity = Compositor::Premultiply(Color{255, 255, 255, 128});
+
+    // downscaled layer, starting and ending beyond its edges, in 16.16 fixed point
+    constexpr double SampleStep = 1.1, SampleOrigin = -0.75;
+    auto sampleAt = [](double texel) { return std::int32_t(std::lround(texel * 65536.0)); };
+
+    const std::vector<Kernel> kernels{
+        {"fill", reset(destination), [fillColor](const SpanKernels &kernels, Surface &target) {
+             kernels.fill(target.pixels.data(), target.pixels.size(), fillColor);
+         },
+         [&] { return exactPixels(count, [&](std::size_t i, int shift) { return exactOver(fillColor, destination[i], shift); }); }},
+        {"blend", reset(destination), [&source](const SpanKernels &kernels, Surface &target) {
+             kernels.blend(target.pixels.data(), source.data(), target.pixels.size());
+         },
+         [&] { return exactPixels(count, [&](std::size_t i, int shift) { return exactOver(source[i], destination[i], shift); }); }},
+        {"opacity", reset(source), [opacity](const SpanKernels &kernels, Surface &target) {
+             kernels.modulate(target.pixels.data(), target.pixels.size(), opacity);
+         },
+         [&] { return exactPixels(count, [&](std::size_t i, int shift) { return channelOf(source[i], shift) * channelOf(opacity, shift) / 255.0; }); }},
+        {"premultiply", reset(straight), [](const SpanKernels &kernels, Surface &target) {
+             kernels.premultiply(target.pixels.data(), target.pixels.size());
+         },
+         [&] {
+             return exactPixels(count, [&](std::size_t i, int shift) {
+                 return shift == 24 ? channelOf(straight[i], 24) : channelOf(straight[i], shift) * channelOf(straight[i], 24) / 255.0;
+             });
+         }},
+        {"bilinear", reset(destination), [&](const SpanKernels &kernels, Surface &target) {
+             for (int y = 0; y < height; ++y)
+                 kernels.sampleBilinear(target.row(y), width, layer, sampleAt(SampleOrigin), sampleAt(SampleOrigin + y * SampleStep),
+                                        sampleAt(SampleStep), 0);
+         },
+         [&] {
+             // same fixed point coordinates as sampled ones
+             return exactPixels(count, [&](std::size_t i, int shift) {
+                 const auto x = (sampleAt(SampleOrigin) + std::int64_t(i % width) * sampleAt(SampleStep)) / 65536.0;
+                 const auto y = sampleAt(SampleOrigin + int(i / width) * SampleStep) / 65536.0;
+                 return exactBilinear(layer, x, y, shift);
+             });
+         }},
+        // scaled and rotated layer with opacity, as `Layer::render` does, only checked against scalar output
+        {"bilinear-blit", reset(destination), [&](const SpanKernels &kernels, Surface &target) {
+             const auto w = (float)width, h = (float)height;
+             Compositor::Blit(target, target.bounds(), layer, Rectangle{0, 0, w, -h},
+                              Rectangle{w / 2, h / 2, w * 0.9f, h * 0.9f}, Vector2{w * 0.45f, h * 0.45f}, 15.0,
+                              Color{255, 255, 255, 200}, Compositor::Filter::Bilinear, scratch, kernels);
+         },
+         nullptr}};
+
+    const std::map<std::string, std::size_t> params{{"width", width}, {"height", height}};
+    const auto &scalar = SpanKernels::Scalar();
+    bool success = true;
+
+    for (const auto &kernel : kernels) {
+        Surface target(width, height);
+        std::vector<std::uint32_t> reference;
+        const auto exact = kernel.exact ? kernel.exact() : std::vector<std::uint32_t>{};
+
+        // scalar first : reference of the others
+        for (const auto *implementation : SpanKernels::Supported()) {
+            auto &result = report.add("kernels", params, 0, kernel.name + "/" + implementation->name);
+            result.megapixels = count / 1e6;
+            for (std::size_t i = 0; i < report.getIterations(); ++i) {
+                kernel.prepare(target);
+                const auto start = Report::Clock::now();
+                kernel.run(*implementation, target);
+                result.timings.push_back(ElapsedMs(start));
+            }
+
+            if (implementation == &scalar)
+                reference = target.pixels;
+
+            // implementations must match scalar one bit for bit, and scalar one be accurate
+            if (const auto error = maxChannelError(reference, target.pixels); error != 0) {
+                std::cerr << "[bench] " << kernel.name << "/" << implementation->name
+                          << " differs from scalar reference by " << error << std::endl;
+                success = false;
+            }
+
+            result.maxError = exact.empty() ? maxChannelError(reference, target.pixels) : maxChannelError(exact, target.pixels);
+            if (!exact.empty() && *result.maxError > 1) {
+                std::cerr << "[bench] " << kernel.name << "/" << implementation->name
+                          << " differs from double precision reference by " << *result.maxError << std::endl;
+                success = false;
+            }
+        }
+    }
+
+    return success;
+}
+
+} // namespace bench
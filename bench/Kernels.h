@@ -0,0 +1,13 @@
+#pragma once
+
+#include "./Benchmark.h"
+
+namespace bench {
+
+// Pixel kernels throughput, every implementation the CPU supports against scalar reference.
+// Every result also records largest channel difference with a double precision reference,
+// or with scalar output for kernels without one.
+// @return `false` if a kernel differs from scalar output at all, or from double precision by more than one unit
+bool RunKernels(Report &report, int width, int height);
+
+} // namespace bench
@@ -0,0 +1,292 @@
+#include "./Scenes.h"
+
+#include <elements/Image.h>
+#include <elements/Row.h>
+#include <elements/Text.h>
+#include <elements/View.h>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <stack>
+
+namespace bench {
+
+namespace {
+
+constexpr const char *ImagePath = "assets/images/cat.png";
+
+std::size_t scaled(std::size_t value, float scale) {
+    return std::max<std::size_t>(1, value * scale);
+}
+
+Color colorOf(std::size_t index) {
+    return Color{(unsigned char)(index * 37), (unsigned char)(index * 91), (unsigned char)(index * 53), 255};
+}
+
+void setSize(std::shared_ptr<ui::element::Element> element, int width, int height) {
+    auto layout = element->getLayout();
+    auto &size = layout.size.emplace();
+    size.width = utils::Value(width);
+    size.height = utils::Value(height);
+    element->updateLayout(layout);
+}
+
+void setBackground(std::shared_ptr<ui::element::Element> element, Color color) {
+    auto style = element->getStyle();
+    style.backgroundColor = color;
+    element->updateStyle(style);
+}
+
+Scene deepChain(std::size_t depth) {
+    return Scene{
+        .name = "deep-chain",
+        .params = {{"depth", depth}},
+        .build = [depth](std::shared_ptr<ui::element::Root> root, Elements &) {
+            std::shared_ptr<ui::element::Element> parent = root;
+            for (std::size_t i = 0; i < depth; ++i) {
+                auto view = std::make_shared<ui::element::View>();
+                parent->appendChild(view);
+
+                auto layout = view->getLayout();
+                layout.spacing.emplace().border = 1;
+                auto &flex = layout.flex.emplace();
+                flex.flex = 1.0;
+                view->updateLayout(layout);
+
+                auto style = view->getStyle();
+                style.borderColor = colorOf(i);
+                view->updateStyle(style);
+
+                parent = view;
+            }
+        }};
+}
+
+Scene wideList(std::size_t count) {
+    return Scene{
+        .name = "wide-list",
+        .params = {{"count", count}},
+        .build = [count](std::shared_ptr<ui::element::Root> root, Elements &) {
+            for (std::size_t i = 0; i < count; ++i) {
+                auto item = std::make_shared<ui::element::View>();
+                root->appendChild(item);
+                setSize(item, 320, 4);
+                setBackground(item, colorOf(i));
+            }
+        }};
+}
+
+Scene balancedTree(std::size_t count, std::size_t fanout) {
+    return Scene{
+        .name = "balanced-tree",
+        .params = {{"count", count}, {"fanout", fanout}},
+        .build = [count, fanout](std::shared_ptr<ui::element::Root> root, Elements &) {
+            Elements parents{root};
+            parents.reserve(count + 1);
+            for (std::size_t i = 0; i < count; ++i) {
+                auto view = std::make_shared<ui::element::View>();
+                parents[i / fanout]->appendChild(view);
+                parents.push_back(view);
+
+                // some subtrees override inherited values
+                if (i % 7 == 0) {
+                    auto style = view->getStyle();
+                    style.inheritables.color = ui::style::MaybeInherited<Color>::New(colorOf(i));
+                    style.inheritables.fontSize = ui::style::MaybeInherited<unsigned int>::New(10 + i % 5);
+                    view->updateStyle(style);
+                }
+            }
+        }};
+}
+
+Scene dashboard(std::size_t cards, std::size_t rows) {
+    return Scene{
+        .name = "dashboard",
+        .params = {{"cards", cards}, {"rows", rows}},
+        .build = [cards, rows](std::shared_ptr<ui::element::Root> root, Elements &) {
+            constexpr int CardWidth = 160, CardHeight = 120, CellsPerRow = 4;
+            const auto columns = std::size_t(1280 / CardWidth);
+
+            for (std::size_t i = 0; i < cards; ++i) {
+                auto card = std::make_shared<ui::element::View>();
+                root->appendChild(card);
+                {
+                    auto layout = card->getLayout();
+                    layout.positionType = ui::style::PositionType::Absolute;
+                    auto &position = layout.position.emplace();
+                    position.left = utils::Value(float(i % columns * CardWidth));
+                    position.top = utils::Value(float(i / columns * CardHeight));
+                    auto &spacing = layout.spacing.emplace();
+                    spacing.padding = utils::Value(4);
+                    layout.flex.emplace().gap = 2;
+                    card->updateLayout(layout);
+                }
+                setSize(card, CardWidth, CardHeight);
+                card->setLayoutBoundary(true);
+
+                for (std::size_t row = 0; row < rows; ++row) {
+                    auto line = std::make_shared<ui::element::Row>();
+                    card->appendChild(line);
+                    {
+                        auto layout = line->getLayout();
+                        auto &flex = layout.flex.emplace();
+                        flex.flexDirection = ui::style::FlexDirection::Row;
+                        flex.flex = 1.0;
+                        flex.gap = 2;
+                        line->updateLayout(layout);
+                    }
+
+                    for (int cell = 0; cell < CellsPerRow; ++cell) {
+                        auto view = std::make_shared<ui::element::View>();
+                        line->appendChild(view);
+
+                        auto layout = view->getLayout();
+                        layout.flex.emplace().flex = float(1 + (row + cell) % 3);
+                        view->updateLayout(layout);
+                        setBackground(view, colorOf(i + row + cell));
+                    }
+                }
+            }
+        }};
+}
+
+Scene textImageGrid(std::size_t rows, std::size_t columns) {
+    return Scene{
+        .name = "text-image-grid",
+        .params = {{"rows", rows}, {"columns", columns}},
+        .build = [rows, columns](std::shared_ptr<ui::element::Root> root, Elements &) {
+            for (std::size_t row = 0; row < rows; ++row) {
+                auto line = std::make_shared<ui::element::Row>();
+                root->appendChild(line);
+                {
+                    auto layout = line->getLayout();
+                    layout.flex.emplace().flexDirection = ui::style::FlexDirection::Row;
+                    line->updateLayout(layout);
+                }
+
+                for (std::size_t column = 0; column < columns; ++column) {
+                    std::shared_ptr<ui::element::Element> cell;
+                    if ((row + column) % 2)
+                        cell = std::make_shared<ui::element::Image>(ImagePath, "cat");
+                    else
+                        cell = std::make_shared<ui::element::Text>(std::format("{}:{}", row, column));
+
+                    line->appendChild(cell);
+                    setSize(cell, 24, 16);
+                }
+            }
+        }};
+}
+
+Scene stackingContexts(std::size_t count) {
+    return Scene{
+        .name = "stacking-contexts",
+        .params = {{"count", count}},
+        .build = [count](std::shared_ptr<ui::element::Root> root, Elements &) {
+            for (std::size_t i = 0; i < count; ++i) {
+                auto view = std::make_shared<ui::element::View>();
+                root->appendChild(view);
+
+                auto layout = view->getLayout();
+                layout.positionType = ui::style::PositionType::Absolute;
+                auto &position = layout.position.emplace();
+                position.top = utils::Value(float(i * 7 % 600));
+                position.left = utils::Value(float(i * 13 % 1200));
+                view->updateLayout(layout);
+                setSize(view, 48, 48);
+
+                auto style = view->getStyle();
+                style.backgroundColor = colorOf(i);
+                style.zIndex = i % 10 + 1;
+                view->updateStyle(style);
+
+                auto child = std::make_shared<ui::element::View>();
+                view->appendChild(child);
+                setSize(child, 24, 24);
+                setBackground(child, colorOf(i + 1));
+            }
+        }};
+}
+
+Scene animations(std::size_t count) {
+    return Scene{
+        .name = "animations",
+        .params = {{"count", count}},
+        .build = [count](std::shared_ptr<ui::element::Root> root, Elements &animated) {
+            auto container = std::make_shared<ui::element::View>();
+            root->appendChild(container);
+            {
+                auto layout = container->getLayout();
+                auto &flex = layout.flex.emplace();
+                flex.flexDirection = ui::style::FlexDirection::Row;
+                flex.flex = 1.0;
+                container->updateLayout(layout);
+            }
+
+            for (std::size_t i = 0; i < count; ++i) {
+                auto view = std::make_shared<ui::element::View>();
+                container->appendChild(view);
+                setSize(view, 32, 32);
+
+                auto style = view->getStyle();
+                style.backgroundColor = colorOf(i);
+                style.opacity = 0.5;
+                auto &translation = style.transform.emplace().translation.emplace();
+                translation.x = utils::Value<float>(0.0);
+                translation.y = utils::Value<float>(1.0);
+                view->updateStyle(style);
+
+                animated.push_back(view);
+            }
+        },
+        .animate = [](const Elements &animated, std::uint64_t frame) {
+            for (std::size_t i = 0; i < animated.size(); ++i) {
+                const auto phase = frame * 0.1f + i;
+                auto style = animated[i]->getStyle();
+                // stays in ]0; 1[ and translated so stacking contexts and layers are kept
+                style.opacity = 0.5f + 0.4f * std::sin(phase);
+                auto &translation = style.transform->translation.emplace();
+                translation.x = utils::Value<float>(8.0f * std::cos(phase));
+                translation.y = utils::Value<float>(1.0f + 8.0f * std::sin(phase));
+                animated[i]->updateStyle(style);
+            }
+        }};
+}
+
+} // namespace
+
+std::vector<Scene> MakeScenes(float scale) {
+    std::vector<Scene> scenes;
+    scenes.push_back(deepChain(scaled(200, scale)));
+    scenes.push_back(wideList(scaled(2000, scale)));
+    scenes.push_back(balancedTree(scaled(20000, scale), 8));
+    scenes.push_back(dashboard(scaled(300, scale), 8));
+    scenes.push_back(textImageGrid(scaled(30, scale), scaled(30, scale)));
+    scenes.push_back(stackingContexts(scaled(200, scale)));
+    scenes.push_back(animations(scaled(100, scale)));
+    return scenes;
+}
+
+std::size_t CountElements(std::shared_ptr<ui::element::Element> root) {
+    return CollectElements(root).size();
+}
+
+Elements CollectElements(std::shared_ptr<ui::element::Element> root) {
+    Elements elements;
+    std::stack<std::shared_ptr<ui::element::Element>> stack;
+    stack.push(root);
+
+    while (!stack.empty()) {
+        auto element = stack.top();
+        stack.pop();
+        elements.push_back(element);
+
+        for (auto child : element->getChildren())
+            stack.push(child);
+    }
+
+    return elements;
+}
+
+} // namespace bench
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <elements/Element.h>
+#include <elements/Root.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+using Elements = std::vector<std::shared_ptr<ui::element::Element>>;
+
+/**
+ * Parametrised synthetic workload.
+ * `build` appends the scene under root and collects animated elements,
+ * `animate` (optional) updates styles of animated elements for given frame.
+ */
+struct Scene {
+    std::string name;
+    std::map<std::string, std::size_t> params;
+    std::function<void(std::shared_ptr<ui::element::Root>, Elements &animated)> build;
+    std::function<void(const Elements &animated, std::uint64_t frame)> animate;
+};
+
+// @param scale Multiplies every scene size
+std::vector<Scene> MakeScenes(float scale);
+
+std::size_t CountElements(std::shared_ptr<ui::element::Element> root);
+
+// Depth-first, root included
+Elements CollectElements(std::shared_ptr<ui::element::Element> root);
+
+} // namespace bench
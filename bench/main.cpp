@@ -0,0 +1,388 @@
+#include "./Benchmark.h"
+#include "./Kernels.h"
+#include "./Scenes.h"
+
+#include <bundle.h>
+#include <event.h>
+#include <repository.h>
+#include <ui.h>
+
+#include <rendering/backend/NullBackend.h>
+#include <rendering/backend/RaylibBackend.h>
+#include <rendering/backend/RecordingBackend.h>
+#include <rendering/backend/SoftwareBackend.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace {
+
+constexpr int ScreenWidth = 1280;
+constexpr int ScreenHeight = 720;
+constexpr std::size_t HitTestPoints = 1000;
+constexpr std::size_t AssetCount = 500;
+constexpr const char *AssetImagePath = "assets/images/cat.png";
+
+struct Options {
+    std::size_t iterations = 20;
+    float scale = 1.0;
+    std::string filter;
+    std::string output;
+    std::string backend = "raylib";
+    bool kernels = false;
+};
+
+void paint(std::shared_ptr<ui::rendering::StackingContext> rootCtx, std::shared_ptr<ui::rendering::Layer> rootLayer, RenderTexture2D target) {
+    auto &backend = ui::rendering::backend::DrawBackend::Get();
+    backend.beginFrame();
+    rootCtx->renderTree();
+    rootLayer->composite();
+
+    backend.beginRenderTarget(target);
+    backend.clear(BLANK);
+    rootLayer->render();
+    backend.endRenderTarget();
+    backend.endFrame();
+}
+
+// Powers of two from 1 to `max`, `max` included
+std::vector<std::size_t> threadCounts(std::size_t max) {
+    std::vector<std::size_t> counts;
+    for (std::size_t threads = 1; threads < max; threads *= 2)
+        counts.push_back(threads);
+    counts.push_back(max);
+    return counts;
+}
+
+// Resizes root and alternates padding of layout boundaries so that every node has to be laid out again
+void invalidateLayout(ui::element::Root &root, const bench::Elements &boundaries, std::size_t iteration) {
+    root.onWindowResized(ScreenWidth - iteration % 2, ScreenHeight);
+    for (const auto &boundary : boundaries) {
+        auto layout = boundary->getLayout();
+        layout.spacing.emplace().padding = utils::Value(int(4 + iteration % 2));
+        boundary->updateLayout(layout);
+    }
+}
+
+// @returns `false` if parallel style propagation or layout differs from single-threaded one
+bool runScene(const bench::Scene &scene, bench::Report &report, RenderTexture2D target) {
+    const auto iterations = report.getIterations();
+    std::shared_ptr<ui::element::Root> root;
+    bench::Elements animated;
+
+    // tree build and finalize need a fresh tree every iteration
+    std::vector<double> buildTimings, finalizeTimings;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        animated.clear();
+
+        auto start = bench::Report::Clock::now();
+        root = std::make_shared<ui::element::Root>(Vector2{ScreenWidth, ScreenHeight});
+        scene.build(root, animated);
+        buildTimings.push_back(bench::ElapsedMs(start));
+
+        start = bench::Report::Clock::now();
+        root->finalize();
+        finalizeTimings.push_back(bench::ElapsedMs(start));
+    }
+
+    const auto elements = bench::CountElements(root);
+    report.add(scene.name, scene.params, elements, "build").timings = buildTimings;
+    report.add(scene.name, scene.params, elements, "finalize").timings = finalizeTimings;
+
+    const auto nodes = bench::CollectElements(root);
+    bench::Elements boundaries;
+    std::copy_if(nodes.begin(), nodes.end(), std::back_inserter(boundaries),
+                 [](const auto &node) { return node->isLayoutBoundary(); });
+
+    auto &layout = report.add(scene.name, scene.params, elements, "layout");
+    for (std::size_t i = 0; i < iterations; ++i) {
+        invalidateLayout(*root, boundaries, i);
+        const auto start = bench::Report::Clock::now();
+        root->calculateLayout();
+        layout.timings.push_back(bench::ElapsedMs(start));
+    }
+
+    // same, layout boundaries laid out by a work-stealing pool of 1 to 16 threads
+    bool identical = true;
+    const std::size_t maxThreads = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), 16);
+    if (!boundaries.empty()) {
+        std::vector<Rectangle> reference;
+        for (const auto &node : nodes)
+            reference.push_back(node->getBoundingRect());
+
+        for (auto threads : threadCounts(maxThreads)) {
+            root->setThreadCount(threads);
+            auto &scaling = report.add(scene.name, scene.params, elements, std::format("layout-{}-threads", threads));
+            for (std::size_t i = 0; i < iterations; ++i) {
+                invalidateLayout(*root, boundaries, i);
+                const auto start = bench::Report::Clock::now();
+                root->calculateLayout();
+                scaling.timings.push_back(bench::ElapsedMs(start));
+            }
+
+            for (std::size_t i = 0; i < nodes.size(); ++i) {
+                const auto rect = nodes[i]->getBoundingRect();
+                if (rect.x != reference[i].x || rect.y != reference[i].y ||
+                    rect.width != reference[i].width || rect.height != reference[i].height) {
+                    std::cerr << "[bench] " << scene.name << " layout differs with " << threads << " threads" << std::endl;
+                    identical = false;
+                    break;
+                }
+            }
+        }
+        root->setThreadCount(1);
+    }
+
+    // change inherited font size so that every node has to update its cache. Root resolves
+    // styles as soon as they change : tree is marked dirty again for the timed pass to do the work
+    auto &styles = report.add(scene.name, scene.params, elements, "styles");
+    for (std::size_t i = 0; i < iterations; ++i) {
+        auto style = root->getStyle();
+        style.inheritables.fontSize = 12 + i % 2;
+        root->updateStyle(style);
+        root->invalidateStyles();
+
+        const auto start = bench::Report::Clock::now();
+        root->propagateStyles();
+        styles.timings.push_back(bench::ElapsedMs(start));
+    }
+
+    // same, subtrees resolved by a work-stealing pool of 1 to 16 threads. Same iteration count,
+    // so last font size and thus every resolved style match the single-threaded pass
+    {
+        std::vector<ui::style::Inheritables> reference;
+        for (const auto &node : nodes)
+            reference.push_back(node->getCachedInheritableProps());
+
+        for (auto threads : threadCounts(maxThreads)) {
+            root->setThreadCount(threads);
+            auto &scaling = report.add(scene.name, scene.params, elements, std::format("styles-{}-threads", threads));
+            for (std::size_t i = 0; i < iterations; ++i) {
+                auto style = root->getStyle();
+                style.inheritables.fontSize = 12 + i % 2;
+                root->updateStyle(style);
+                root->invalidateStyles();
+
+                const auto start = bench::Report::Clock::now();
+                root->propagateStyles();
+                scaling.timings.push_back(bench::ElapsedMs(start));
+            }
+
+            for (std::size_t i = 0; i < nodes.size(); ++i)
+                if (nodes[i]->getCachedInheritableProps() != reference[i]) {
+                    std::cerr << "[bench] " << scene.name << " styles differ with " << threads << " threads" << std::endl;
+                    identical = false;
+                    break;
+                }
+        }
+        root->setThreadCount(1);
+    }
+
+    std::shared_ptr<ui::rendering::StackingContext> rootCtx;
+    std::shared_ptr<ui::rendering::Layer> rootLayer;
+    auto &trees = report.add(scene.name, scene.params, elements, "stacking-layer-build");
+    for (std::size_t i = 0; i < iterations; ++i) {
+        rootLayer = nullptr;
+        const auto start = bench::Report::Clock::now();
+        rootCtx = ui::rendering::StackingContext::BuildTree(root);
+        rootLayer = ui::rendering::Layer::BuildTree(rootCtx);
+        trees.timings.push_back(bench::ElapsedMs(start));
+    }
+
+    auto &painting = report.add(scene.name, scene.params, elements, "paint");
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const auto start = bench::Report::Clock::now();
+        paint(rootCtx, rootLayer, target);
+        painting.timings.push_back(bench::ElapsedMs(start));
+    }
+
+    // software rasterizer scaling : 1, 2, 4 ... threads up to every core
+    using ui::rendering::backend::SoftwareBackend;
+    if (auto software = dynamic_cast<SoftwareBackend *>(&ui::rendering::backend::DrawBackend::Get())) {
+        constexpr double Megapixels = ScreenWidth * ScreenHeight / 1e6;
+        painting.megapixels = Megapixels;
+
+        const auto defaultThreads = software->getThreadCount();
+        const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        for (auto threads : threadCounts(cores)) {
+            software->setThreadCount(threads);
+            auto &scaling = report.add(scene.name, scene.params, elements, std::format("paint-{}-threads", threads));
+            scaling.megapixels = Megapixels;
+            for (std::size_t i = 0; i < iterations; ++i) {
+                const auto start = bench::Report::Clock::now();
+                paint(rootCtx, rootLayer, target);
+                scaling.timings.push_back(bench::ElapsedMs(start));
+            }
+        }
+        software->setThreadCount(defaultThreads);
+    }
+
+    if (scene.animate) {
+        auto &animation = report.add(scene.name, scene.params, elements, "animate");
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const auto start = bench::Report::Clock::now();
+            scene.animate(animated, i);
+            root->update();
+            paint(rootCtx, rootLayer, target);
+            animation.timings.push_back(bench::ElapsedMs(start));
+        }
+    }
+
+    std::minstd_rand random(42);
+    std::uniform_real_distribution<float> x(0, ScreenWidth), y(0, ScreenHeight);
+    auto &hitTest = report.add(scene.name, scene.params, elements, "hit-test");
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const auto start = bench::Report::Clock::now();
+        for (std::size_t point = 0; point < HitTestPoints; ++point)
+            event::EventDispatcher::HitTest(rootCtx, Vector2{x(random), y(random)});
+        hitTest.timings.push_back(bench::ElapsedMs(start));
+    }
+
+    return identical;
+}
+
+// Startup asset loading : same image registered `AssetCount` times, decoded from its file
+// then uploaded from a bundle, into a fresh texture repository every iteration.
+// Files and bundle are in page cache after first iteration, this measures decoding against mapping
+bool runAssets(bench::Report &report, float scale) {
+    const auto count = std::max<std::size_t>(1, AssetCount * scale);
+    const auto bundlePath = std::filesystem::temp_directory_path() / "RetainedUI_bench.bundle";
+    {
+        bundle::BundleWriter writer;
+        for (std::size_t i = 0; i < count; ++i)
+            if (!writer.addTextureFile(std::format("asset-{}", i), AssetImagePath))
+                return false;
+        if (!writer.write(bundlePath))
+            return false;
+    }
+
+    const std::map<std::string, std::size_t> params{{"assets", count}};
+    auto measure = [&](const std::string &stage, auto &&load) {
+        auto &result = report.add("assets", params, count, stage);
+        for (std::size_t i = 0; i < report.getIterations(); ++i) {
+            auto repositories = repository::InitRepositories();
+            const auto start = bench::Report::Clock::now();
+            load(*repository::TextureRepository::Get());
+            result.timings.push_back(bench::ElapsedMs(start));
+            repository::Repository::Clear(repositories);
+        }
+    };
+
+    bool loaded = true;
+    measure("load-files", [&](repository::TextureRepository &textures) {
+        for (std::size_t i = 0; i < count; ++i)
+            loaded &= textures.load(std::format("asset-{}", i), AssetImagePath);
+    });
+    measure("load-bundle", [&](repository::TextureRepository &textures) {
+        loaded &= repository::MountBundle(bundlePath);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto name = std::format("asset-{}", i);
+            loaded &= textures.load(name, name);
+        }
+    });
+
+    std::filesystem::remove(bundlePath);
+    if (!loaded)
+        std::cerr << "[bench] assets failed to load" << std::endl;
+    return loaded;
+}
+
+} // namespace
+
+// RetainedUI_bench [--iterations n] [--scale f] [--filter scene] [--output file.json] [--backend raylib|null|recording|software]
+// null and recording backends measure CPU-side paint only and need neither window nor GPU,
+// software backend also reports rasterizer megapixels per second from 1 to every core.
+// Style propagation and layout of layout boundaries are also timed on 1 to 16 threads,
+// fails if any result differs from single-threaded one.
+// Loading textures from loose files is then compared to loading them from an asset bundle ("assets" scene).
+// RetainedUI_bench --kernels [--iterations n] : compositing kernels against scalar reference, fails beyond one unit of error
+int main(int argc, char **argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string option(argv[i]);
+        if (option == "--kernels")
+            options.kernels = true;
+        else if (i + 1 >= argc)
+            break;
+        else if (option == "--iterations")
+            options.iterations = std::max(1ul, std::stoul(argv[++i]));
+        else if (option == "--scale")
+            options.scale = std::stof(argv[++i]);
+        else if (option == "--filter")
+            options.filter = argv[++i];
+        else if (option == "--output")
+            options.output = argv[++i];
+        else if (option == "--backend")
+            options.backend = argv[++i];
+    }
+
+    if (options.kernels) {
+        bench::Report report(options.iterations);
+        const bool success = bench::RunKernels(report, ScreenWidth, ScreenHeight);
+
+        if (options.output.empty())
+            std::cout << report.toJson();
+        else
+            std::ofstream(options.output) << report.toJson();
+
+        return success ? 0 : 1;
+    }
+
+    using namespace ui::rendering::backend;
+    if (options.backend == "null")
+        DrawBackend::Set(std::make_unique<NullBackend>(ScreenWidth, ScreenHeight));
+    else if (options.backend == "recording")
+        DrawBackend::Set(std::make_unique<RecordingBackend>(ScreenWidth, ScreenHeight));
+    else if (options.backend == "software")
+        DrawBackend::Set(std::make_unique<SoftwareBackend>(ScreenWidth, ScreenHeight));
+    else
+        DrawBackend::Set(std::make_unique<RaylibBackend>());
+
+    SetTraceLogLevel(LOG_WARNING);
+    const bool needsWindow = DrawBackend::Get().needsWindow();
+    if (needsWindow) {
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        InitWindow(ScreenWidth, ScreenHeight, "RetainedUI_bench");
+    }
+
+    bench::Report report(options.iterations);
+    bool success = true;
+    {
+        auto repositories = repository::InitRepositories();
+        auto target = DrawBackend::Get().loadRenderTarget(ScreenWidth, ScreenHeight);
+
+        for (const auto &scene : bench::MakeScenes(options.scale)) {
+            if (!options.filter.empty() && scene.name.find(options.filter) == std::string::npos)
+                continue;
+
+            std::cerr << "[bench] " << scene.name << std::endl;
+            success &= runScene(scene, report, target);
+        }
+
+        DrawBackend::Get().unloadRenderTarget(target);
+        repository::Repository::Clear(repositories);
+    }
+
+    if (options.filter.empty() || std::string("assets").find(options.filter) != std::string::npos) {
+        std::cerr << "[bench] assets" << std::endl;
+        success &= runAssets(report, options.scale);
+    }
+
+    DrawBackend::Set(nullptr);
+    if (needsWindow)
+        CloseWindow();
+
+    if (options.output.empty())
+        std::cout << report.toJson();
+    else
+        std::ofstream(options.output) << report.toJson();
+
+    return success ? 0 : 1;
+}
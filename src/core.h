@@ -1,4 +1,6 @@
 #pragma once
 
+#include "./core/Engine.h"
 #include "./core/event.h"
+#include "./core/profiling.h"
 #include "./core/repository.h"
\ No newline at end of file
@@ -0,0 +1,516 @@
+#include "./Engine.h"
+#include "./event/EventListeners.h"
+#include "./profiling/Profiler.h"
+#include "./repository.h"
+
+#include <elements/ProfilerOverlay.h>
+#include <rendering/DebugOverlay.h>
+#include <rendering/RenderStats.h>
+#include <rendering/RenderTargetPool.h>
+#include <rendering/backend/NullBackend.h>
+#include <rendering/backend/RaylibBackend.h>
+#include <rendering/backend/RecordingBackend.h>
+#include <rendering/backend/SoftwareBackend.h>
+#include <rendering/backend/ThreadedBackend.h>
+
+#include <cmath>
+#include <exception>
+#include <stack>
+#include <thread>
+
+Engine::WindowInitialization::WindowInitialization(const Options &options) : windowOpened(false) {
+    using namespace ui::rendering::backend;
+
+    std::unique_ptr<DrawBackend> backend;
+    switch (options.backend) {
+    case Backend::Raylib:
+        backend = std::make_unique<RaylibBackend>();
+        break;
+    case Backend::Recording:
+        backend = std::make_unique<RecordingBackend>(options.width, options.height);
+        break;
+    case Backend::Null:
+        backend = std::make_unique<NullBackend>(options.width, options.height);
+        break;
+    case Backend::Software:
+        backend = std::make_unique<SoftwareBackend>(options.width, options.height);
+        break;
+    }
+
+    if (options.threadedRendering)
+        backend = std::make_unique<ThreadedBackend>(std::move(backend));
+    DrawBackend::Set(std::move(backend));
+
+    if (!DrawBackend::Get().needsWindow())
+        return;
+
+    SetConfigFlags((options.headless ? FLAG_WINDOW_HIDDEN : FLAG_WINDOW_RESIZABLE) | (options.vsync ? FLAG_VSYNC_HINT : 0));
+    InitWindow(options.width, options.height, options.title.c_str());
+    windowOpened = true;
+}
+
+Engine::WindowInitialization::~WindowInitialization() {
+    ui::rendering::backend::DrawBackend::Set(nullptr);
+    if (windowOpened)
+        CloseWindow();
+}
+
+Engine::Engine() : Engine(Options{}) {}
+
+Engine::Engine(const Options &options)
+    : _options(options), _windowInit(options), _frame(0), _requestNewFrame(true),
+      _windowLayoutSize(options.width, options.height), _stopRequested(false),
+      _scheduler(scheduler::Milliseconds(options.frameBudget.value_or(1000.0f / std::max(1, options.targetFPS)))),
+      _executor(_scheduler, [this] { requestFrame(); }), _lastStepTime(0), _wakeRequested(false), _waitingForEvents(false) {
+    if (_options.backend != Backend::Raylib)
+        _options.headless = true;
+
+    if (_windowInit.windowOpened && !IsWindowReady()) {
+        const std::string errorMessage("[Engine] Unable to create window or graphics context.");
+        TraceLog(LOG_FATAL, errorMessage.c_str());
+        throw std::runtime_error(errorMessage);
+    }
+
+    if (_options.headless) {
+        _offscreenTarget = ui::rendering::backend::DrawBackend::Get().loadRenderTarget(_options.width, _options.height);
+        if (_offscreenTarget->id == 0) {
+            const std::string errorMessage("[Engine] Unable to create offscreen render target.");
+            TraceLog(LOG_FATAL, errorMessage.c_str());
+            throw std::runtime_error(errorMessage);
+        }
+    } else if (_options.threadedRendering)
+        SetTargetFPS(_options.targetFPS); // UI thread is paced by presentation
+    // otherwise `step` waits for the end of the frame period itself, after idle callbacks
+
+    if (_windowInit.windowOpened)
+        _lastStepTime = GetTime();
+    _scheduler.setWakeUp([this] { wakeUp(); });
+
+    _repositories = repository::InitRepositories();
+    repository::TextureRepository::Get()->setMemoryBudget(_options.textureBudget);
+    for (const auto &bundle : _options.bundles)
+        repository::MountBundle(bundle);
+    _elementsRoot = std::make_shared<ui::element::Root>(Vector2{
+        .x = (float)_options.width,
+        .y = (float)_options.height});
+    _elementsRoot->setThreadCount(_options.uiThreads);
+    _eventManager = std::make_unique<event::EventManager>(_elementsRoot);
+}
+
+Engine::~Engine() {
+    // rendering trees own GPU resources, release them before the window
+    _layerRoot = nullptr;
+    _stackingContextRoot = nullptr;
+    _eventManager = nullptr;
+    _elementsRoot = nullptr;
+
+    if (_offscreenTarget)
+        ui::rendering::backend::DrawBackend::Get().unloadRenderTarget(*_offscreenTarget);
+
+    repository::Repository::Clear(_repositories);
+}
+
+void Engine::setup() {
+    if (_layerRoot)
+        return;
+
+#ifdef UI_PROFILING
+    _elementsRoot->appendChild(std::make_shared<ui::element::ProfilerOverlay>());
+#endif
+
+    // F2 : toggle repaint heat-map and layer/stacking context outlines
+    _elementsRoot->getEventListeners().add<event::data::KeyDown>([this](event::Event &e) {
+        const auto &data = e.unwrapData<event::data::KeyDown>();
+        if (data.key == KEY_F2 && !data.repeat) {
+            ui::rendering::DebugOverlay::Get().toggle();
+            requestFrame();
+        }
+    });
+
+    _elementsRoot->finalize();
+
+    _stackingContextRoot = ui::rendering::StackingContext::BuildTree(_elementsRoot);
+    _layerRoot = ui::rendering::Layer::BuildTree(_stackingContextRoot);
+}
+
+void Engine::rebuildLayers() {
+    // drop every layer first so that the new tree gets their render targets back from the pool
+    std::stack<std::shared_ptr<ui::rendering::StackingContext>> stack;
+    stack.push(_stackingContextRoot);
+    while (!stack.empty()) {
+        auto ctx = stack.top();
+        stack.pop();
+        ctx->setLayer(nullptr);
+        for (auto child : ctx->getChildren())
+            stack.push(child);
+    }
+
+    _layerRoot = nullptr;
+    _layerRoot = ui::rendering::Layer::BuildTree(_stackingContextRoot);
+}
+
+std::shared_ptr<ui::element::Root> Engine::getRoot() const {
+    return _elementsRoot;
+}
+
+std::shared_ptr<ui::rendering::StackingContext> Engine::getStackingContextRoot() const {
+    return _stackingContextRoot;
+}
+
+std::shared_ptr<ui::rendering::Layer> Engine::getLayerRoot() const {
+    return _layerRoot;
+}
+
+event::EventManager *Engine::getEventManager() const {
+    return _eventManager.get();
+}
+
+scheduler::FrameScheduler &Engine::getScheduler() {
+    return _scheduler;
+}
+
+const Engine::Options &Engine::getOptions() const {
+    return _options;
+}
+
+std::uint64_t Engine::getFrame() const {
+    return _frame;
+}
+
+std::optional<RenderTexture2D> Engine::getOffscreenTarget() const {
+    return _offscreenTarget;
+}
+
+bool Engine::recordInput(const std::filesystem::path &path) {
+    return _eventManager->startRecording(path);
+}
+
+bool Engine::replayInput(const std::filesystem::path &path) {
+    return _eventManager->startReplay(path, _options.fixedTimestep.value_or(16));
+}
+
+void Engine::logRenderStats(bool log) {
+    ui::rendering::RenderStats::Get().setLogEverySecond(log);
+}
+
+bool Engine::shouldStop() const {
+    if (_stopRequested)
+        return true;
+
+    if (_options.frameCount && _frame >= *_options.frameCount)
+        return true;
+
+    if (_eventManager->isReplayFinished())
+        return true;
+
+    // render thread polls the window in threaded mode
+    return !_options.headless && !_options.threadedRendering && WindowShouldClose();
+}
+
+void Engine::render() {
+    auto &backend = ui::rendering::backend::DrawBackend::Get();
+    ui::rendering::DebugOverlay::Get().beginFrame(backend.getScreenWidth(), backend.getScreenHeight());
+
+    backend.beginFrame();
+    _stackingContextRoot->renderTree();
+    {
+        PROFILE_PHASE(profiling::Phase::Composite);
+        _layerRoot->composite();
+
+        // layers switch render targets, offscreen target can only be bound once they are done
+        if (_offscreenTarget) {
+            backend.beginRenderTarget(*_offscreenTarget);
+            backend.clear(BLANK);
+        }
+
+        _layerRoot->render();
+    }
+    ui::rendering::DebugOverlay::Get().draw(_stackingContextRoot, _layerRoot);
+
+    if (_offscreenTarget)
+        backend.endRenderTarget();
+
+    {
+        PROFILE_PHASE(profiling::Phase::Present);
+        backend.endFrame();
+    }
+    repository::TextureRepository::Get()->enforceBudget(); // textures drawn this frame are spared
+    ui::rendering::RenderStats::Get().endFrame(backend.getScreenWidth(), backend.getScreenHeight());
+}
+
+void Engine::step() {
+    setup();
+    _scheduler.beginFrame();
+    {
+        std::lock_guard lock(_wakeMutex);
+        _wakeRequested = false;
+    }
+
+    bool windowResized = false;
+    {
+        PROFILE_PHASE(profiling::Phase::Events);
+        if (_options.threadedRendering && !_eventManager->isReplaying()) {
+            // frames sampled by render thread since last step
+            while (auto frame = _inputFrames.tryPop()) {
+                _eventManager->update(*frame);
+                windowResized |= _eventManager->isWindowResized();
+            }
+        } else {
+            // raylib frame time is stale once frames are skipped
+            float measuredDt = 16;
+            if (_windowInit.windowOpened && !_options.threadedRendering) {
+                const auto now = GetTime();
+                measuredDt = (now - _lastStepTime) * 1000;
+                _lastStepTime = now;
+            }
+            const auto dt = _options.fixedTimestep.value_or(measuredDt);
+            _eventManager->update(dt);
+            if (_eventManager->isReplayFinished())
+                return;
+            windowResized = _eventManager->isWindowResized();
+        }
+
+        _eventManager->dispatchEvents();
+        _scheduler.runTimers();
+        _scheduler.runTasks(scheduler::Priority::Input);
+    }
+
+    {
+        PROFILE_PHASE(profiling::Phase::Animation);
+        _scheduler.runAnimationFrames();
+    }
+    _scheduler.runTasks(scheduler::Priority::Render);
+
+    if (windowResized) {
+        const auto &input = _eventManager->getInputFrame();
+        _windowLayoutSize = {input.windowWidth, input.windowHeight};
+        _elementsRoot->onWindowResized(input.windowWidth, input.windowHeight);
+    }
+
+    // update inherited properties
+    // and check for layout dirty flag
+    _elementsRoot->update();
+
+    // windowed frames are only painted once something changed
+    const bool onDemand = _options.renderOnDemand && !_options.headless;
+    const bool rendered = !onDemand || _requestNewFrame.exchange(false) || _elementsRoot->needsRepaint();
+    if (rendered)
+        render();
+
+    {
+        PROFILE_PHASE(profiling::Phase::Idle);
+        _scheduler.runIdle();
+    }
+
+    // nothing painted nor due : sleep instead of spinning on a static screen, until next timer at most
+    const bool idle = onDemand && !rendered && !_scheduler.hasPendingWork() && !shouldStop();
+    if (idle)
+        waitForWork(_scheduler.getNextTimerDue());
+    else if (!rendered && _windowInit.windowOpened && !_options.threadedRendering)
+        PollInputEvents(); // prevent window from freezing
+
+    // keeps a steady frame rate whatever idle work took, swaps wait for vertical sync themselves
+    if (!idle && _windowInit.windowOpened && !_options.threadedRendering && _options.targetFPS > 0 &&
+        !(rendered && _options.vsync)) {
+        const auto remaining = scheduler::Milliseconds(1000.0 / _options.targetFPS) - _scheduler.getElapsed();
+        if (remaining.count() > 0)
+            WaitTime(remaining.count() / 1000);
+    }
+
+    PROFILE_FRAME_END();
+    _frame++;
+}
+
+void Engine::run() {
+    if (_options.threadedRendering)
+        return runThreaded();
+
+    setup();
+
+    while (!shouldStop())
+        step();
+}
+
+void Engine::runThreaded() {
+    auto &backend = static_cast<ui::rendering::backend::ThreadedBackend &>(ui::rendering::backend::DrawBackend::Get());
+    // screen size must be known before layers are built
+    backend.runTasks();
+
+    std::atomic<bool> finished = false;
+    std::exception_ptr error;
+    std::thread uiThread([this, &finished, &error] {
+        try {
+            setup();
+            while (!shouldStop())
+                step();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        finished = true;
+    });
+
+    // this thread owns the window : presents committed frames and samples input
+    event::InputSampler sampler;
+    auto lastSample = GetTime();
+    while (!finished) {
+        const auto presented = backend.processTasks(std::chrono::milliseconds(16));
+        if (!_windowInit.windowOpened)
+            continue;
+
+        // window keeps responding while UI thread is busy
+        if (!presented)
+            PollInputEvents();
+
+        // whole milliseconds, remainder is carried over
+        const auto measuredDt = (std::uint32_t)((GetTime() - lastSample) * 1000);
+        _inputFrames.push(sampler.sample(_options.fixedTimestep.value_or(measuredDt)));
+        lastSample += measuredDt / 1000.0;
+        wakeUp();
+
+        if (WindowShouldClose())
+            requestStop();
+    }
+
+    uiThread.join();
+    backend.runTasks();
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void Engine::requestStop() {
+    _stopRequested = true;
+    wakeUp();
+}
+
+void Engine::requestFrame() {
+    _requestNewFrame = true;
+    wakeUp();
+}
+
+void Engine::wakeUp() {
+    {
+        std::lock_guard lock(_wakeMutex);
+        _wakeRequested = true;
+    }
+    _wakeCondition.notify_all();
+
+    // only needed while the loop blocks on window events
+    if (_waitingForEvents)
+        ui::rendering::backend::DrawBackend::Get().wakeEvents();
+}
+
+void Engine::waitForWork(std::optional<scheduler::Clock::time_point> deadline) {
+    if (_options.threadedRendering) {
+        // render thread pushes an input frame every time it polls the window
+        std::unique_lock lock(_wakeMutex);
+        auto woken = [this] { return _wakeRequested || !_inputFrames.empty(); };
+        if (deadline)
+            _wakeCondition.wait_until(lock, *deadline, woken);
+        else
+            _wakeCondition.wait(lock, woken);
+        return;
+    }
+
+    if (!_windowInit.windowOpened)
+        return;
+
+    // raised first : a `wakeUp` either sees it or is seen below
+    _waitingForEvents = true;
+    bool woken;
+    {
+        std::lock_guard lock(_wakeMutex);
+        woken = _wakeRequested;
+    }
+
+    auto &backend = ui::rendering::backend::DrawBackend::Get();
+    if (woken)
+        PollInputEvents();
+    else
+        backend.waitEvents(deadline);
+    _waitingForEvents = false;
+}
+
+bool Engine::snapshot(const SnapshotOptions &options, snapshot::Frame &frame) {
+    if (options.width <= 0 || options.height <= 0 || options.scale <= 0) {
+        TraceLog(LOG_ERROR, "[Engine] Invalid snapshot size %dx%d at scale %f", options.width, options.height, options.scale);
+        return false;
+    }
+
+    setup();
+    auto &backend = ui::rendering::backend::DrawBackend::Get();
+    auto &pool = ui::rendering::RenderTargetPool::Get();
+
+    const auto layoutWidth = std::max(1, (int)std::lround(options.width / options.scale));
+    const auto layoutHeight = std::max(1, (int)std::lround(options.height / options.scale));
+
+    const auto output = pool.acquire(options.width, options.height);
+    const bool scaled = layoutWidth != options.width || layoutHeight != options.height;
+    const auto layoutTarget = scaled ? pool.acquire(layoutWidth, layoutHeight) : output;
+    if (output.id == 0 || layoutTarget.id == 0) {
+        TraceLog(LOG_ERROR, "[Engine] Unable to create snapshot render target.");
+        pool.release(output);
+        if (scaled)
+            pool.release(layoutTarget);
+        return false;
+    }
+
+    // laid out at snapshot size, layers capped to it instead of screen size
+    const bool resized = _windowLayoutSize != std::make_pair(layoutWidth, layoutHeight);
+    const bool rebuilt = resized || backend.getScreenWidth() != layoutWidth || backend.getScreenHeight() != layoutHeight;
+    if (resized)
+        _elementsRoot->onWindowResized(layoutWidth, layoutHeight);
+    _elementsRoot->update();
+    if (rebuilt) {
+        ui::rendering::Layer::SetSizeCap(std::make_pair(layoutWidth, layoutHeight));
+        rebuildLayers();
+    }
+
+    // never presented : a visible window keeps its frame and input
+    const auto presentedFrames = backend.getPresentedFrameCount();
+    backend.beginOffscreenPass();
+    _stackingContextRoot->renderTree();
+    _layerRoot->composite();
+
+    backend.beginRenderTarget(layoutTarget);
+    backend.clear(BLANK);
+    _layerRoot->render();
+    backend.endRenderTarget();
+
+    if (scaled) {
+        backend.beginRenderTarget(output);
+        backend.clear(BLANK);
+        backend.drawTexture(layoutTarget.texture,
+                            Rectangle{0, 0, (float)layoutWidth, -(float)layoutHeight},
+                            Rectangle{0, 0, (float)options.width, (float)options.height},
+                            Vector2{0, 0}, 0.0, WHITE);
+        backend.endRenderTarget();
+    }
+    backend.endOffscreenPass();
+    ui::rendering::RenderStats::Get().endFrame(options.width, options.height);
+    if (_windowInit.windowOpened && backend.getPresentedFrameCount() != presentedFrames)
+        TraceLog(LOG_WARNING, "[Engine] Snapshot presented a window frame");
+
+    // window layout and its layers are back for next frame
+    if (resized) {
+        _elementsRoot->onWindowResized(_windowLayoutSize.first, _windowLayoutSize.second);
+        _elementsRoot->update();
+    }
+    if (rebuilt) {
+        ui::rendering::Layer::SetSizeCap(std::nullopt);
+        rebuildLayers();
+        requestFrame();
+    }
+
+    frame.width = options.width;
+    frame.height = options.height;
+    const auto read = backend.readPixels(output, frame.pixels);
+    if (!read) {
+        TraceLog(LOG_WARNING, "[Engine] Draw backend does not keep pixels, snapshot is blank");
+        frame.pixels.assign(std::size_t(options.width) * options.height, BLANK);
+    }
+
+    pool.release(output);
+    if (scaled)
+        pool.release(layoutTarget);
+    return read;
+}
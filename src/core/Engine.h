@@ -0,0 +1,170 @@
+#pragma once
+
+#include "./ThreadSafeQueue.h"
+#include "./async/Executor.h"
+#include "./event/EventManager.h"
+#include "./repository/Repository.h"
+#include "./scheduler/FrameScheduler.h"
+#include "./snapshot/Frame.h"
+
+#include <elements/Root.h>
+#include <rendering/Layer.h>
+#include <rendering/StackingContext.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * Owns the window, the element tree and the rendering trees, and drives the frame pipeline :
+ * input -> events -> layout/styles -> paint (stacking contexts) -> composite (layers) -> present.
+ * Build the element tree under `getRoot()` then call `run()`.
+ */
+class Engine {
+  public:
+    enum class Backend {
+        Raylib,    // window and GPU
+        Recording, // commands kept in memory, no window
+        Null,      // commands discarded, no window
+        Software   // rasterized on CPU worker threads, no window
+    };
+
+    struct Options {
+        // Anything but raylib implies headless mode
+        Backend backend = Backend::Raylib;
+        int width = 640;
+        int height = 480;
+        std::string title = "Retained UI with raylib";
+        // Hidden window, frames are composited into an offscreen target instead of the back buffer
+        bool headless = false;
+        // Stop after this many frames
+        std::optional<std::uint64_t> frameCount;
+        // Delta-time in milliseconds reported every frame instead of measured time
+        std::optional<std::uint32_t> fixedTimestep;
+        // Ignored in headless mode, frames are produced as fast as possible
+        int targetFPS = 60;
+        // Frames are paced by buffer swaps instead of waiting for target frame period
+        bool vsync = false;
+        // Windowed frames are only painted when something changed or `requestFrame` was called,
+        // the loop sleeps until input or new work while nothing did. Headless frames are always painted
+        bool renderOnDemand = true;
+        // Events, layout and paint run on a UI thread while the thread calling `run()`,
+        // owning the window, presents committed command lists and samples input
+        bool threadedRendering = false;
+        // Threads resolving inherited styles and laying out layout boundaries, calling thread included
+        std::size_t uiThreads = 1;
+        // Milliseconds of work per frame, idle callbacks get what is left. Defaults to target frame period
+        std::optional<float> frameBudget;
+        // Bytes of textures kept resident, textures not drawn lately get evicted beyond. 0 for no limit
+        std::uint64_t textureBudget = 0;
+        // Asset bundles mounted before the element tree is built, packed fonts and textures are loaded from them
+        std::vector<std::filesystem::path> bundles;
+    };
+
+    struct SnapshotOptions {
+        // Output size in pixels
+        int width = 640;
+        int height = 480;
+        // Output pixels per layout unit : tree is laid out at `width / scale` x `height / scale`
+        // then the composited frame is resampled to output size
+        float scale = 1.0;
+    };
+
+  private:
+    /**
+     * RAII window and draw backend initialization/destrucation
+     * makes sure to run only after every other attributes have been destroyed
+     */
+    struct WindowInitialization {
+        bool windowOpened;
+
+        WindowInitialization(const Options &options);
+        ~WindowInitialization();
+    };
+
+    Options _options;
+    WindowInitialization _windowInit; // gets destroyed last
+    std::optional<RenderTexture2D> _offscreenTarget;
+    std::shared_ptr<ui::element::Root> _elementsRoot;
+    std::shared_ptr<ui::rendering::StackingContext> _stackingContextRoot;
+    std::shared_ptr<ui::rendering::Layer> _layerRoot;
+    std::vector<repository::Repository *> _repositories;
+    std::unique_ptr<event::EventManager> _eventManager;
+    std::uint64_t _frame;
+    std::atomic<bool> _requestNewFrame;
+    std::pair<int, int> _windowLayoutSize; // root size, restored after snapshots
+    ThreadSafeQueue<event::InputFrame> _inputFrames; // sampled by render thread
+    std::atomic<bool> _stopRequested;
+    scheduler::FrameScheduler _scheduler;
+    async::Executor _executor; // coroutines resume through `_scheduler`
+    double _lastStepTime; // seconds, windowed single-threaded mode
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCondition;
+    bool _wakeRequested;                  // since frame start
+    std::atomic<bool> _waitingForEvents;  // loop blocked on window events
+
+    // Finalizes element tree and builds rendering trees, once
+    void setup();
+
+    // Replaces layer tree, render targets of the previous one get recycled
+    void rebuildLayers();
+
+    bool shouldStop() const;
+    void render();
+
+    // Blocks until input, `wakeUp` or `deadline`, polls input in single-threaded windowed mode
+    void waitForWork(std::optional<scheduler::Clock::time_point> deadline);
+
+    // Ends `waitForWork`, may be called from any thread
+    void wakeUp();
+
+    // `run` with UI and render threads
+    void runThreaded();
+
+  public:
+    Engine();
+    Engine(const Options &options);
+    ~Engine();
+
+    std::shared_ptr<ui::element::Root> getRoot() const;
+    std::shared_ptr<ui::rendering::StackingContext> getStackingContextRoot() const;
+    std::shared_ptr<ui::rendering::Layer> getLayerRoot() const;
+    event::EventManager *getEventManager() const;
+
+    // Input, animation, render and idle work run by each frame
+    scheduler::FrameScheduler &getScheduler();
+
+    const Options &getOptions() const;
+    std::uint64_t getFrame() const;
+
+    // Composited frame, headless mode only
+    std::optional<RenderTexture2D> getOffscreenTarget() const;
+
+    bool recordInput(const std::filesystem::path &path);
+    bool replayInput(const std::filesystem::path &path);
+    void logRenderStats(bool log);
+
+    // Renders element tree offscreen into `frame`, whose storage is reused between calls.
+    // Tree is laid out at snapshot size with layers capped to it, window layout and layers are restored after.
+    // Render targets are recycled through the pool between calls, a visible window is never resized.
+    bool snapshot(const SnapshotOptions &options, snapshot::Frame &frame);
+
+    // Runs a single frame of the pipeline :
+    // events, timers, input tasks, animation frames, render tasks, layout/styles, paint, idle callbacks
+    void step();
+
+    // Runs frames until window is closed, frame count is reached or replay is over
+    void run();
+
+    // Makes `run` return after current frame, may be called from any thread
+    void requestStop();
+
+    // Paints next frame even if nothing was invalidated, may be called from any thread
+    void requestFrame();
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Hash map split into independently locked shards : readers of a shard share its lock,
+ * writers only block the shard their key hashes to.
+ * Values are returned by copy, never by reference into the map.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>, std::size_t ShardCount = 16>
+class ShardedMap {
+    static_assert(ShardCount > 0 && (ShardCount & (ShardCount - 1)) == 0, "ShardCount must be a power of two");
+
+    // own cache line each, so uncontended shards do not share one
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<K, V, Hash> datas;
+    };
+
+    std::array<Shard, ShardCount> _shards;
+    Hash _hash;
+
+    // high bits : unordered_map buckets already use the low ones
+    Shard &shardOf(const K &key) {
+        const auto hash = _hash(key);
+        return _shards[(hash ^ (hash >> 16)) & (ShardCount - 1)];
+    }
+
+    const Shard &shardOf(const K &key) const {
+        return const_cast<ShardedMap *>(this)->shardOf(key);
+    }
+
+  public:
+    std::optional<V> find(const K &key) const {
+        auto &shard = shardOf(key);
+        std::shared_lock lock(shard.mutex);
+        if (auto it = shard.datas.find(key); it != shard.datas.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+    // Returns replaced value if any
+    std::optional<V> assign(const K &key, V value) {
+        auto &shard = shardOf(key);
+        std::lock_guard lock(shard.mutex);
+        auto [it, inserted] = shard.datas.try_emplace(key, value);
+        if (inserted)
+            return std::nullopt;
+        return std::exchange(it->second, std::move(value));
+    }
+
+    // Returns erased value if any
+    std::optional<V> erase(const K &key) {
+        auto &shard = shardOf(key);
+        std::lock_guard lock(shard.mutex);
+        auto node = shard.datas.extract(key);
+        if (node.empty())
+            return std::nullopt;
+        return std::move(node.mapped());
+    }
+
+    // Returns every value, leaving the map empty
+    std::vector<V> drain() {
+        std::vector<V> values;
+        for (auto &shard : _shards) {
+            std::lock_guard lock(shard.mutex);
+            for (auto &[key, value] : shard.datas)
+                values.push_back(std::move(value));
+            shard.datas.clear();
+        }
+        return values;
+    }
+
+    std::size_t size() const {
+        std::size_t count = 0;
+        for (auto &shard : _shards) {
+            std::shared_lock lock(shard.mutex);
+            count += shard.datas.size();
+        }
+        return count;
+    }
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "./ThreadSafeQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Fixed set of workers pulling tasks from a shared queue.
+ * Pending tasks are still run on destruction, then workers are joined.
+ */
+class ThreadPool {
+    ThreadSafeQueue<std::function<void()>> _tasks;
+    std::vector<std::thread> _workers;
+
+  public:
+    // @param threadCount Workers to spawn, 0 means every task runs on the calling thread
+    explicit ThreadPool(std::size_t threadCount = std::max(1u, std::thread::hardware_concurrency())) {
+        _workers.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+            _workers.emplace_back([this] {
+                while (auto task = _tasks.waitPop())
+                    (*task)();
+            });
+    }
+
+    ~ThreadPool() {
+        _tasks.close();
+        for (auto &worker : _workers)
+            worker.join();
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    std::size_t getThreadCount() const {
+        return _workers.size();
+    }
+
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F &&task) {
+        using Result = std::invoke_result_t<F>;
+
+        // std::function must be copyable, packaged_task is not
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        auto future = packaged->get_future();
+
+        if (_workers.empty())
+            (*packaged)();
+        else
+            _tasks.push([packaged] { (*packaged)(); });
+
+        return future;
+    }
+
+    // Calls `task(i)` for every i in [0; count[, calling thread takes part.
+    // Returns once every call is done, rethrows first exception raised by a worker.
+    template <typename F>
+    void parallelFor(std::size_t count, F &&task) {
+        if (count == 0)
+            return;
+
+        auto next = std::make_shared<std::atomic<std::size_t>>(0);
+        auto run = [next, count, &task] {
+            for (auto i = next->fetch_add(1); i < count; i = next->fetch_add(1))
+                task(i);
+        };
+
+        std::vector<std::future<void>> helpers;
+        const auto helperCount = std::min(_workers.size(), count - 1);
+        helpers.reserve(helperCount);
+        for (std::size_t i = 0; i < helperCount; ++i)
+            helpers.push_back(submit(run));
+
+        run();
+        for (auto &helper : helpers)
+            helper.get();
+    }
+};
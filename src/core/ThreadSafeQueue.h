@@ -1,12 +1,82 @@
 #pragma once
 
-#include <queue>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
+#include <optional>
+#include <queue>
 
-template<typename T>
+/**
+ * Unbounded multi-producer multi-consumer FIFO.
+ * Once closed, consumers still pop remaining values and are never blocked again.
+ */
+template <typename T>
 class ThreadSafeQueue {
     std::queue<T> _datas;
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _closed = false;
+
+  public:
+    void push(T value) {
+        {
+            std::lock_guard lock(_mutex);
+            _datas.push(std::move(value));
+        }
+        _condition.notify_one();
+    }
+
+    std::optional<T> tryPop() {
+        std::lock_guard lock(_mutex);
+        if (_datas.empty())
+            return std::nullopt;
+
+        auto value = std::move(_datas.front());
+        _datas.pop();
+        return value;
+    }
+
+    // Blocks until a value is available, `std::nullopt` once queue is closed and drained
+    std::optional<T> waitPop() {
+        std::unique_lock lock(_mutex);
+        _condition.wait(lock, [this] { return _closed || !_datas.empty(); });
+        if (_datas.empty())
+            return std::nullopt;
+
+        auto value = std::move(_datas.front());
+        _datas.pop();
+        return value;
+    }
+
+    // Same as `waitPop`, giving up after `timeout`
+    template <typename Rep, typename Period>
+    std::optional<T> waitPop(std::chrono::duration<Rep, Period> timeout) {
+        std::unique_lock lock(_mutex);
+        _condition.wait_for(lock, timeout, [this] { return _closed || !_datas.empty(); });
+        if (_datas.empty())
+            return std::nullopt;
+
+        auto value = std::move(_datas.front());
+        _datas.pop();
+        return value;
+    }
+
+    // Wakes every waiting consumer
+    void close() {
+        {
+            std::lock_guard lock(_mutex);
+            _closed = true;
+        }
+        _condition.notify_all();
+    }
 
-public:
+    bool empty() const {
+        std::lock_guard lock(_mutex);
+        return _datas.empty();
+    }
 
-};
\ No newline at end of file
+    std::size_t size() const {
+        std::lock_guard lock(_mutex);
+        return _datas.size();
+    }
+};
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * Fork-join pool for recursive work : tasks spawned by a thread go to its own deque,
+ * popped newest first (depth first, cache friendly), idle threads steal oldest tasks
+ * of the others (biggest subtrees first).
+ * Workers sleep between `run` calls and spin while a run has pending tasks.
+ * `run` must not be called concurrently nor from inside a task.
+ */
+class WorkStealingPool {
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> _queues; // one per thread, calling thread of `run` is 0
+    std::vector<std::thread> _workers;
+    std::atomic<std::size_t> _pending;  // spawned and not finished
+    std::atomic<std::size_t> _sleeping; // workers waiting for a run
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    bool _stopping;
+
+    std::mutex _errorMutex;
+    std::exception_ptr _error; // first exception of current run
+
+    static inline thread_local WorkStealingPool *currentPool = nullptr;
+    static inline thread_local std::size_t currentIndex = 0;
+
+    bool pop(std::size_t index, std::function<void()> &task) {
+        auto &queue = *_queues[index];
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty())
+            return false;
+
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(std::size_t index, std::function<void()> &task) {
+        for (std::size_t i = 1; i < _queues.size(); ++i) {
+            auto &queue = *_queues[(index + i) % _queues.size()];
+            std::lock_guard lock(queue.mutex);
+            if (queue.tasks.empty())
+                continue;
+
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    bool runOne(std::size_t index) {
+        std::function<void()> task;
+        if (!pop(index, task) && !steal(index, task))
+            return false;
+
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard lock(_errorMutex);
+            if (!_error)
+                _error = std::current_exception();
+        }
+        _pending.fetch_sub(1);
+        return true;
+    }
+
+    void work(std::size_t index) {
+        currentPool = this;
+        currentIndex = index;
+
+        while (true) {
+            {
+                std::unique_lock lock(_mutex);
+                _sleeping.fetch_add(1);
+                _wake.wait(lock, [this] { return _stopping || _pending.load() > 0; });
+                _sleeping.fetch_sub(1);
+                if (_stopping)
+                    return;
+            }
+
+            while (_pending.load() > 0)
+                if (!runOne(index))
+                    std::this_thread::yield();
+        }
+    }
+
+  public:
+    // @param threadCount Threads running tasks, calling thread of `run` included
+    explicit WorkStealingPool(std::size_t threadCount = std::max(1u, std::thread::hardware_concurrency()))
+        : _pending(0), _sleeping(0), _stopping(false) {
+        threadCount = std::max<std::size_t>(1, threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+            _queues.push_back(std::make_unique<Queue>());
+
+        _workers.reserve(threadCount - 1);
+        for (std::size_t i = 1; i < threadCount; ++i)
+            _workers.emplace_back([this, i] { work(i); });
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+        for (auto &worker : _workers)
+            worker.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    std::size_t getThreadCount() const {
+        return _queues.size();
+    }
+
+    // Queues `task` on calling thread deque, from `run` caller or from inside a task
+    void spawn(std::function<void()> task) {
+        const auto index = currentPool == this ? currentIndex : 0;
+        _pending.fetch_add(1);
+        {
+            auto &queue = *_queues[index];
+            std::lock_guard lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+
+        // sleepers check `_pending` under `_mutex`, locking it prevents a lost wake up
+        if (_sleeping.load() > 0) {
+            { std::lock_guard lock(_mutex); }
+            _wake.notify_one();
+        }
+    }
+
+    // Runs `root` and every task spawned from it, calling thread takes part.
+    // Returns once all are done, rethrows first exception raised by a task.
+    void run(std::function<void()> root) {
+        auto previousPool = std::exchange(currentPool, this);
+        auto previousIndex = std::exchange(currentIndex, 0);
+
+        spawn(std::move(root));
+        while (_pending.load() > 0)
+            if (!runOne(0))
+                std::this_thread::yield();
+
+        currentPool = previousPool;
+        currentIndex = previousIndex;
+
+        std::exception_ptr error;
+        {
+            std::lock_guard lock(_errorMutex);
+            std::swap(error, _error);
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+};
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "./async/Awaitables.h"
+#include "./async/Executor.h"
+#include "./async/FramePool.h"
+#include "./async/Task.h"
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "./Executor.h"
+#include "./Task.h"
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace async {
+
+namespace detail {
+
+// Destroying the awaiting task then calls `cancel`, `Task` coroutines only
+template <typename Promise>
+void setCancel(std::coroutine_handle<Promise> handle, std::function<void()> cancel) {
+    if constexpr (std::is_base_of_v<PromiseBase, Promise>)
+        handle.promise().cancel = std::move(cancel);
+}
+
+template <typename Promise>
+void resumeScheduled(std::coroutine_handle<Promise> handle) {
+    if constexpr (std::is_base_of_v<PromiseBase, Promise>)
+        handle.promise().cancel = nullptr;
+    handle.resume();
+}
+
+} // namespace detail
+
+// `co_await NextFrame()` : resumes in the animation phase of next frame, with its timestamp in milliseconds.
+// Awaited on the UI thread
+struct NextFrame {
+    double timestamp = 0;
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle) {
+        const auto id = Executor::Get().getScheduler().requestAnimationFrame([this, handle](double frameTimestamp) {
+            timestamp = frameTimestamp;
+            detail::resumeScheduled(handle);
+        });
+        detail::setCancel(handle, [id] {
+            if (Executor::Exists())
+                Executor::Get().getScheduler().cancelAnimationFrame(id);
+        });
+    }
+
+    double await_resume() const noexcept {
+        return timestamp;
+    }
+};
+
+// `co_await Delay(ms)` : resumes at the start of the first frame after `delay`. Awaited on the UI thread
+struct Delay {
+    scheduler::Milliseconds delay;
+
+    explicit Delay(scheduler::Milliseconds delay) : delay(delay) {}
+    explicit Delay(double milliseconds) : delay(milliseconds) {}
+
+    bool await_ready() const noexcept {
+        return delay.count() <= 0;
+    }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle) {
+        const auto id = Executor::Get().getScheduler().setTimeout([handle] { detail::resumeScheduled(handle); }, delay);
+        detail::setCancel(handle, [id] {
+            if (Executor::Exists())
+                Executor::Get().getScheduler().clearTimeout(id);
+        });
+    }
+
+    void await_resume() const noexcept {}
+};
+
+// `co_await SwitchToWorker()` : following code runs on a worker thread
+struct SwitchToWorker {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        Executor::Get().runOnWorker([handle] { handle.resume(); });
+    }
+
+    void await_resume() const noexcept {}
+};
+
+// `co_await SwitchToUiThread()` : following code runs on the UI thread, before layout and paint
+struct SwitchToUiThread {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        Executor::Get().runOnUiThread([handle] { handle.resume(); });
+    }
+
+    void await_resume() const noexcept {}
+};
+
+// `co_await Worker(function)` : calls `function` on a worker thread then resumes on the UI thread
+// with its result, or rethrows what it threw
+template <typename F>
+Task<std::invoke_result_t<F>> Worker(F function) {
+    using Result = std::invoke_result_t<F>;
+
+    co_await SwitchToWorker();
+    std::exception_ptr error;
+    if constexpr (std::is_void_v<Result>) {
+        try {
+            function();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        co_await SwitchToUiThread();
+        if (error)
+            std::rethrow_exception(error);
+    } else {
+        std::optional<Result> result;
+        try {
+            result.emplace(function());
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        co_await SwitchToUiThread();
+        if (error)
+            std::rethrow_exception(error);
+        co_return std::move(*result);
+    }
+}
+
+} // namespace async
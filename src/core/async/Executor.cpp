@@ -0,0 +1,56 @@
+#include "./Executor.h"
+
+#include <raylib.h>
+
+#include <stdexcept>
+#include <string>
+
+namespace async {
+
+Executor *Executor::instance = nullptr;
+
+Executor::Executor(scheduler::FrameScheduler &scheduler, std::function<void()> requestFrame, std::size_t workerCount)
+    : _scheduler(scheduler), _requestFrame(std::move(requestFrame)) {
+    _workers.emplace(workerCount);
+    if (instance)
+        TraceLog(LOG_WARNING, "[Executor] Replacing existing executor");
+    instance = this;
+}
+
+Executor::~Executor() {
+    _workers.reset();
+    if (instance == this)
+        instance = nullptr;
+}
+
+Executor &Executor::Get() {
+    if (!instance) {
+        const std::string errorMessage("[Executor] No executor, awaiting requires an engine.");
+        TraceLog(LOG_FATAL, errorMessage.c_str());
+        throw std::logic_error(errorMessage);
+    }
+    return *instance;
+}
+
+bool Executor::Exists() {
+    return instance != nullptr;
+}
+
+scheduler::FrameScheduler &Executor::getScheduler() {
+    return _scheduler;
+}
+
+void Executor::runOnWorker(std::function<void()> task) {
+    _workers->submit(std::move(task));
+}
+
+void Executor::runOnUiThread(std::function<void()> task) {
+    _scheduler.post(scheduler::Priority::Render, std::move(task));
+}
+
+void Executor::requestFrame() {
+    if (_requestFrame)
+        _requestFrame();
+}
+
+} // namespace async
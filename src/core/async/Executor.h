@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../ThreadPool.h"
+#include "../scheduler/FrameScheduler.h"
+
+#include <functional>
+#include <optional>
+
+namespace async {
+
+/**
+ * Where awaiting coroutines resume : the UI thread, through the frame scheduler, or worker threads.
+ * Engine owns one for its lifetime. Coroutines still suspended when it is destroyed are never resumed.
+ */
+class Executor {
+    static Executor *instance;
+
+    scheduler::FrameScheduler &_scheduler;
+    std::function<void()> _requestFrame;
+    std::optional<ThreadPool> _workers; // reset first on destruction, running tasks may still await
+
+  public:
+    // @param workerCount Threads running `Worker` functions
+    Executor(scheduler::FrameScheduler &scheduler, std::function<void()> requestFrame,
+             std::size_t workerCount = std::max(2u, std::thread::hardware_concurrency()) - 1);
+    ~Executor();
+
+    Executor(const Executor &) = delete;
+    Executor &operator=(const Executor &) = delete;
+
+    // Throws if there is no executor
+    static Executor &Get();
+
+    static bool Exists();
+
+    scheduler::FrameScheduler &getScheduler();
+
+    // Runs `task` on a worker thread
+    void runOnWorker(std::function<void()> task);
+
+    // Runs `task` on the UI thread, before layout and paint of a coming frame
+    void runOnUiThread(std::function<void()> task);
+
+    // Paints next frame, for results nothing else invalidates (e.g. assets)
+    void requestFrame();
+};
+
+} // namespace async
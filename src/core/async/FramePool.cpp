@@ -0,0 +1,70 @@
+#include "./FramePool.h"
+
+#include <array>
+#include <new>
+#include <utility>
+
+namespace async {
+
+namespace {
+
+constexpr std::size_t ClassCount = FramePool::MaxPooledSize / FramePool::Granularity;
+
+// intrusive list, blocks are at least `Granularity` bytes
+struct FreeBlock {
+    FreeBlock *next;
+};
+
+struct FreeLists {
+    std::array<FreeBlock *, ClassCount> heads{};
+    std::array<std::size_t, ClassCount> counts{};
+
+    ~FreeLists() {
+        for (auto head : heads)
+            while (head)
+                ::operator delete(std::exchange(head, head->next));
+    }
+};
+
+thread_local FreeLists freeLists;
+
+std::size_t classOf(std::size_t size) {
+    return (size + FramePool::Granularity - 1) / FramePool::Granularity - 1;
+}
+
+} // namespace
+
+void *FramePool::Allocate(std::size_t size) {
+    if (size > MaxPooledSize)
+        return ::operator new(size);
+
+    const auto index = classOf(size);
+    auto &head = freeLists.heads[index];
+    if (!head)
+        return ::operator new((index + 1) * Granularity);
+
+    freeLists.counts[index]--;
+    return std::exchange(head, head->next);
+}
+
+void FramePool::Deallocate(void *pointer, std::size_t size) noexcept {
+    const auto index = classOf(size);
+    if (size > MaxPooledSize || freeLists.counts[index] >= MaxCachedBlocks) {
+        ::operator delete(pointer);
+        return;
+    }
+
+    auto block = static_cast<FreeBlock *>(pointer);
+    block->next = freeLists.heads[index];
+    freeLists.heads[index] = block;
+    freeLists.counts[index]++;
+}
+
+std::size_t FramePool::GetCachedBlockCount() {
+    std::size_t count = 0;
+    for (auto classCount : freeLists.counts)
+        count += classCount;
+    return count;
+}
+
+} // namespace async
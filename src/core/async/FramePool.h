@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+namespace async {
+
+/**
+ * Allocator of coroutine frames : freed blocks are kept in per-thread free lists by size class
+ * and handed back to the next frame of the same class, so that short-lived tasks do not hit the heap.
+ * Frames bigger than `MaxPooledSize` go straight to the heap.
+ */
+class FramePool {
+  public:
+    static constexpr std::size_t Granularity = 64;
+    static constexpr std::size_t MaxPooledSize = 1024;
+    static constexpr std::size_t MaxCachedBlocks = 256; // per size class and thread
+
+    static void *Allocate(std::size_t size);
+    static void Deallocate(void *pointer, std::size_t size) noexcept;
+
+    // Blocks waiting for reuse on calling thread
+    static std::size_t GetCachedBlockCount();
+};
+
+} // namespace async
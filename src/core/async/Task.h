@@ -0,0 +1,204 @@
+#pragma once
+
+#include "./FramePool.h"
+
+#include <raylib.h>
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <utility>
+
+namespace async {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation; // awaiting coroutine
+    std::exception_ptr error;
+    bool detached = false; // frees itself once done
+    std::function<void()> cancel; // drops the scheduler callback that would resume this frame, see `Awaitables.h`
+
+    // Before destroying a suspended frame, so that nothing resumes it afterwards
+    void cancelPending() {
+        if (auto pending = std::exchange(cancel, nullptr))
+            pending();
+    }
+
+    static void *operator new(std::size_t size) {
+        return FramePool::Allocate(size);
+    }
+
+    static void operator delete(void *pointer, std::size_t size) noexcept {
+        FramePool::Deallocate(pointer, size);
+    }
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            auto &promise = handle.promise();
+            if (promise.continuation)
+                return promise.continuation;
+
+            if (promise.detached) {
+                if (promise.error) {
+                    try {
+                        std::rethrow_exception(promise.error);
+                    } catch (const std::exception &e) {
+                        TraceLog(LOG_ERROR, "[async] Detached task failed : %s", e.what());
+                    } catch (...) {
+                        TraceLog(LOG_ERROR, "[async] Detached task failed");
+                    }
+                }
+                handle.destroy();
+            }
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    // lazy : starts when awaited or detached
+    std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept {
+        return {};
+    }
+
+    void unhandled_exception() {
+        error = std::current_exception();
+    }
+
+    void rethrowIfFailed() const {
+        if (error)
+            std::rethrow_exception(error);
+    }
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object();
+
+    template <typename U>
+    void return_value(U &&result) {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T result() {
+        rethrowIfFailed();
+        return std::move(*value);
+    }
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    Task<void> get_return_object();
+
+    void return_void() const {}
+
+    void result() const {
+        rethrowIfFailed();
+    }
+};
+
+} // namespace detail
+
+/**
+ * Lazy coroutine : runs once awaited, resuming the awaiting coroutine when done (exceptions included),
+ * or once detached. Where it resumes after its own `co_await` is up to the awaited object,
+ * see `Awaitables.h`. Frames come from `FramePool`.
+ * Coroutine arguments should be taken by value : references may dangle before the task starts.
+ * Destroying a task suspended on `NextFrame` or `Delay` cancels its scheduler callback,
+ * one suspended on a thread switch (`Worker` included) must be detached instead.
+ */
+template <typename T>
+class Task {
+  public:
+    using promise_type = detail::Promise<T>;
+
+  private:
+    std::coroutine_handle<promise_type> _handle;
+
+  public:
+    explicit Task(std::coroutine_handle<promise_type> handle) : _handle(handle) {}
+
+    Task(Task &&other) noexcept : _handle(std::exchange(other._handle, {})) {}
+
+    Task &operator=(Task &&other) noexcept {
+        if (this != &other) {
+            if (_handle) {
+                _handle.promise().cancelPending();
+                _handle.destroy();
+            }
+            _handle = std::exchange(other._handle, {});
+        }
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    ~Task() {
+        if (_handle) {
+            _handle.promise().cancelPending();
+            _handle.destroy();
+        }
+    }
+
+    bool done() const {
+        return !_handle || _handle.done();
+    }
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        _handle.promise().continuation = awaiting;
+        return _handle;
+    }
+
+    T await_resume() {
+        return _handle.promise().result();
+    }
+
+    // Runs until first suspension on calling thread, frame is freed once done.
+    // Failures are logged
+    void detach() && {
+        auto handle = std::exchange(_handle, {});
+        handle.promise().detached = true;
+        handle.resume();
+    }
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> Promise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+} // namespace detail
+
+// Fire and forget
+inline void Spawn(Task<void> task) {
+    std::move(task).detach();
+}
+
+} // namespace async
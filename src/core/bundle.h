@@ -0,0 +1,5 @@
+#pragma once
+
+#include "./bundle/AssetBundle.h"
+#include "./bundle/BundleWriter.h"
+#include "./bundle/Format.h"
@@ -0,0 +1,134 @@
+#include "./AssetBundle.h"
+#include "../profiling/Tracer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace bundle {
+
+namespace {
+
+template <typename T>
+const T *at(const MappedFile &file, std::uint64_t offset) {
+    return reinterpret_cast<const T *>(file.data() + offset);
+}
+
+bool fits(std::uint64_t offset, std::uint64_t size, std::uint64_t limit) {
+    return offset <= limit && size <= limit - offset;
+}
+
+} // namespace
+
+AssetBundle::AssetBundle(const std::filesystem::path &path) : _path(path), _file(path) {}
+
+std::shared_ptr<AssetBundle> AssetBundle::Open(const std::filesystem::path &path) {
+    TRACE_ZONE_CATEGORY("AssetBundle::Open", "asset");
+    std::shared_ptr<AssetBundle> bundle(new AssetBundle(path));
+    const auto &file = bundle->_file;
+    if (!file.isOpen()) {
+        TraceLog(LOG_ERROR, "[AssetBundle] Unable to map %s", path.string().c_str());
+        return nullptr;
+    }
+
+    const auto header = at<Header>(file, 0);
+    if (file.size() < sizeof(Header) || std::memcmp(header->magic, Magic, sizeof(Magic)) != 0) {
+        TraceLog(LOG_ERROR, "[AssetBundle] %s is not an asset bundle", path.string().c_str());
+        return nullptr;
+    }
+
+    if (header->version != Version) {
+        TraceLog(LOG_ERROR, "[AssetBundle] %s has version %u, expected %u", path.string().c_str(), header->version, Version);
+        return nullptr;
+    }
+
+    if (header->fileSize != file.size() || header->entriesOffset % Alignment != 0 ||
+        !fits(header->entriesOffset, std::uint64_t(header->entryCount) * sizeof(Entry), file.size())) {
+        TraceLog(LOG_ERROR, "[AssetBundle] %s is truncated", path.string().c_str());
+        return nullptr;
+    }
+
+    bundle->_entries = {at<Entry>(file, header->entriesOffset), header->entryCount};
+    for (const auto &entry : bundle->_entries) {
+        if (!fits(entry.nameOffset, entry.nameLength, file.size()) || entry.dataOffset % Alignment != 0 ||
+            !fits(entry.dataOffset, entry.dataSize, file.size())) {
+            TraceLog(LOG_ERROR, "[AssetBundle] %s has an entry out of bounds", path.string().c_str());
+            return nullptr;
+        }
+    }
+
+    return bundle;
+}
+
+const std::filesystem::path &AssetBundle::getPath() const {
+    return _path;
+}
+
+std::size_t AssetBundle::getEntryCount() const {
+    return _entries.size();
+}
+
+std::string_view AssetBundle::nameOf(const Entry &entry) const {
+    return {at<char>(_file, entry.nameOffset), entry.nameLength};
+}
+
+const Entry *AssetBundle::find(EntryKind kind, std::string_view name) const {
+    auto it = std::lower_bound(_entries.begin(), _entries.end(), name, [this](const Entry &entry, std::string_view name) {
+        return nameOf(entry) < name;
+    });
+
+    // same name may be packed as texture and font
+    for (; it != _entries.end() && nameOf(*it) == name; ++it)
+        if (it->kind == kind)
+            return &*it;
+    return nullptr;
+}
+
+std::optional<::Image> AssetBundle::imageAt(const TextureHeader &header, std::uint64_t pixelsOffset, const Entry &entry) const {
+    if (header.width <= 0 || header.height <= 0 || header.mipmaps != 1)
+        return std::nullopt;
+
+    const auto size = GetPixelDataSize(header.width, header.height, header.format);
+    if (size <= 0 || !fits(pixelsOffset, size, entry.dataOffset + entry.dataSize))
+        return std::nullopt;
+
+    return ::Image{
+        .data = const_cast<std::byte *>(_file.data() + pixelsOffset),
+        .width = header.width,
+        .height = header.height,
+        .mipmaps = header.mipmaps,
+        .format = header.format};
+}
+
+std::optional<::Image> AssetBundle::findTexture(std::string_view name) const {
+    auto entry = find(EntryKind::Texture, name);
+    if (!entry || entry->dataSize < sizeof(TextureHeader))
+        return std::nullopt;
+
+    const auto &header = *at<TextureHeader>(_file, entry->dataOffset);
+    return imageAt(header, entry->dataOffset + sizeof(TextureHeader), *entry);
+}
+
+std::optional<FontView> AssetBundle::findFont(std::string_view name) const {
+    auto entry = find(EntryKind::Font, name);
+    if (!entry || entry->dataSize < sizeof(FontHeader))
+        return std::nullopt;
+
+    const auto &header = *at<FontHeader>(_file, entry->dataOffset);
+    const auto glyphsOffset = entry->dataOffset + sizeof(FontHeader);
+    const auto glyphsSize = std::uint64_t(std::max(header.glyphCount, 0)) * sizeof(GlyphRecord);
+    if (header.glyphCount <= 0 || !fits(glyphsOffset, glyphsSize, entry->dataOffset + entry->dataSize))
+        return std::nullopt;
+
+    auto atlas = imageAt(header.atlas, glyphsOffset + glyphsSize, *entry);
+    if (!atlas)
+        return std::nullopt;
+
+    return FontView{
+        .baseSize = header.baseSize,
+        .glyphCount = header.glyphCount,
+        .glyphPadding = header.glyphPadding,
+        .glyphs = at<GlyphRecord>(_file, glyphsOffset),
+        .atlas = *atlas};
+}
+
+} // namespace bundle
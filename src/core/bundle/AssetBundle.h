@@ -0,0 +1,55 @@
+#pragma once
+
+#include "./Format.h"
+#include "./MappedFile.h"
+
+#include <raylib.h>
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace bundle {
+
+// Bundled font, pointing into the mapping
+struct FontView {
+    int baseSize;
+    int glyphCount;
+    int glyphPadding;
+    const GlyphRecord *glyphs;
+    ::Image atlas;
+};
+
+/**
+ * Memory-mapped asset bundle (see `Format.h`). Images and fonts it returns point into the mapping :
+ * they are only valid while the bundle is and must never be unloaded, upload them as they are.
+ * Safe to read from any thread.
+ */
+class AssetBundle {
+    std::filesystem::path _path;
+    MappedFile _file;
+    std::span<const Entry> _entries;
+
+    AssetBundle(const std::filesystem::path &path);
+
+    const Entry *find(EntryKind kind, std::string_view name) const;
+    std::string_view nameOf(const Entry &entry) const;
+
+    // `header` followed by pixels, in bounds of `entry`
+    std::optional<::Image> imageAt(const TextureHeader &header, std::uint64_t pixelsOffset, const Entry &entry) const;
+
+  public:
+    // nullptr if `path` is not a valid bundle
+    static std::shared_ptr<AssetBundle> Open(const std::filesystem::path &path);
+
+    const std::filesystem::path &getPath() const;
+    std::size_t getEntryCount() const;
+
+    // Binary search over sorted index, no allocation
+    std::optional<::Image> findTexture(std::string_view name) const;
+    std::optional<FontView> findFont(std::string_view name) const;
+};
+
+} // namespace bundle
@@ -0,0 +1,175 @@
+#include "./BundleWriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <tuple>
+
+namespace bundle {
+
+namespace {
+
+std::uint64_t aligned(std::uint64_t offset) {
+    return (offset + Alignment - 1) / Alignment * Alignment;
+}
+
+template <typename T>
+void append(std::vector<std::byte> &data, const T &value) {
+    const auto bytes = reinterpret_cast<const std::byte *>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+void appendPixels(std::vector<std::byte> &data, const ::Image &image) {
+    const auto bytes = static_cast<const std::byte *>(image.data);
+    data.insert(data.end(), bytes, bytes + GetPixelDataSize(image.width, image.height, image.format));
+}
+
+TextureHeader headerOf(const ::Image &image) {
+    return TextureHeader{.width = image.width, .height = image.height, .format = image.format, .mipmaps = 1};
+}
+
+bool isPackable(const ::Image &image) {
+    return image.data && image.width > 0 && image.height > 0 && image.mipmaps == 1;
+}
+
+} // namespace
+
+bool BundleWriter::addTexture(const std::string &name, const ::Image &image) {
+    if (!isPackable(image)) {
+        TraceLog(LOG_ERROR, "[BundleWriter] %s : only single mipmap images can be packed", name.c_str());
+        return false;
+    }
+
+    auto &entry = _entries.emplace_back(EntryKind::Texture, name);
+    append(entry.data, headerOf(image));
+    appendPixels(entry.data, image);
+    return true;
+}
+
+bool BundleWriter::addTextureFile(const std::string &name, const std::filesystem::path &path) {
+    auto image = LoadImage(path.string().c_str());
+    if (!image.data) {
+        TraceLog(LOG_ERROR, "[BundleWriter] Unable to decode %s", path.string().c_str());
+        return false;
+    }
+
+    const auto added = addTexture(name, image);
+    UnloadImage(image);
+    return added;
+}
+
+bool BundleWriter::addFontFile(const std::string &name, const std::filesystem::path &path) {
+    int dataSize = 0;
+    auto data = LoadFileData(path.string().c_str(), &dataSize);
+    if (!data) {
+        TraceLog(LOG_ERROR, "[BundleWriter] Unable to read %s", path.string().c_str());
+        return false;
+    }
+
+    auto glyphs = LoadFontData(data, dataSize, FontBaseSize, nullptr, FontGlyphCount, FONT_DEFAULT);
+    UnloadFileData(data);
+    if (!glyphs) {
+        TraceLog(LOG_ERROR, "[BundleWriter] Unable to rasterize %s", path.string().c_str());
+        return false;
+    }
+
+    Rectangle *recs = nullptr;
+    auto atlas = GenImageFontAtlas(glyphs, &recs, FontGlyphCount, FontBaseSize, FontGlyphPadding, 0);
+    const auto packable = isPackable(atlas);
+    if (packable) {
+        auto &entry = _entries.emplace_back(EntryKind::Font, name);
+        append(entry.data, FontHeader{
+                               .baseSize = FontBaseSize,
+                               .glyphCount = FontGlyphCount,
+                               .glyphPadding = FontGlyphPadding,
+                               .reserved = 0,
+                               .atlas = headerOf(atlas)});
+        for (int i = 0; i < FontGlyphCount; ++i)
+            append(entry.data, GlyphRecord{
+                                   .value = glyphs[i].value,
+                                   .offsetX = glyphs[i].offsetX,
+                                   .offsetY = glyphs[i].offsetY,
+                                   .advanceX = glyphs[i].advanceX,
+                                   .x = recs[i].x,
+                                   .y = recs[i].y,
+                                   .width = recs[i].width,
+                                   .height = recs[i].height});
+        appendPixels(entry.data, atlas);
+    } else
+        TraceLog(LOG_ERROR, "[BundleWriter] Unable to build glyph atlas of %s", path.string().c_str());
+
+    UnloadImage(atlas);
+    MemFree(recs);
+    UnloadFontData(glyphs, FontGlyphCount);
+    return packable;
+}
+
+std::size_t BundleWriter::getEntryCount() const {
+    return _entries.size();
+}
+
+bool BundleWriter::write(const std::filesystem::path &path) const {
+    // stable : of duplicates, last added comes last and is kept
+    std::vector<const PendingEntry *> sorted;
+    for (const auto &entry : _entries)
+        sorted.push_back(&entry);
+    std::stable_sort(sorted.begin(), sorted.end(), [](auto a, auto b) {
+        return std::tie(a->name, a->kind) < std::tie(b->name, b->kind);
+    });
+    auto kept = std::unique(sorted.rbegin(), sorted.rend(), [](auto a, auto b) {
+        return a->kind == b->kind && a->name == b->name;
+    });
+    sorted.erase(sorted.begin(), kept.base());
+
+    // layout : header, index, names, then payloads
+    Header header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.entryCount = static_cast<std::uint32_t>(sorted.size());
+    header.entriesOffset = aligned(sizeof(Header));
+
+    std::vector<Entry> entries(sorted.size());
+    auto offset = header.entriesOffset + sorted.size() * sizeof(Entry);
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        entries[i].kind = sorted[i]->kind;
+        entries[i].nameLength = static_cast<std::uint32_t>(sorted[i]->name.size());
+        entries[i].nameOffset = offset;
+        offset += sorted[i]->name.size();
+    }
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        offset = aligned(offset);
+        entries[i].dataOffset = offset;
+        entries[i].dataSize = sorted[i]->data.size();
+        offset += sorted[i]->data.size();
+    }
+    header.fileSize = offset;
+
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        TraceLog(LOG_ERROR, "[BundleWriter] Unable to open %s for writing", path.string().c_str());
+        return false;
+    }
+
+    auto pad = [&output](std::uint64_t offset) {
+        static const char zeros[Alignment]{};
+        output.write(zeros, offset - output.tellp());
+    };
+
+    output.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    pad(header.entriesOffset);
+    output.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(Entry));
+    for (auto entry : sorted)
+        output.write(entry->name.data(), entry->name.size());
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        pad(entries[i].dataOffset);
+        output.write(reinterpret_cast<const char *>(sorted[i]->data.data()), sorted[i]->data.size());
+    }
+
+    if (!output) {
+        TraceLog(LOG_ERROR, "[BundleWriter] Failed writing %s", path.string().c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace bundle
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "./Format.h"
+
+#include <raylib.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace bundle {
+
+/**
+ * Builds an asset bundle (see `Format.h`) : assets are decoded or rasterized here,
+ * once, so that loading them from the bundle is a mere upload.
+ * Names are what repositories are asked to load, usually the original paths.
+ */
+class BundleWriter {
+    struct PendingEntry {
+        EntryKind kind;
+        std::string name;
+        std::vector<std::byte> data;
+    };
+
+    std::vector<PendingEntry> _entries;
+
+  public:
+    // Pixels are copied, only single mipmap images are supported
+    bool addTexture(const std::string &name, const ::Image &image);
+
+    // Decoded like TextureRepository does
+    bool addTextureFile(const std::string &name, const std::filesystem::path &path);
+
+    // Rasterized like DrawBackend::loadFont does, atlas and glyph metrics are stored
+    bool addFontFile(const std::string &name, const std::filesystem::path &path);
+
+    std::size_t getEntryCount() const;
+
+    // Index sorted by name, last entry added wins over entries of same kind and name
+    bool write(const std::filesystem::path &path) const;
+};
+
+} // namespace bundle
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Asset bundle layout, written by the packer tool and memory-mapped at runtime.
+ * Little-endian, every offset is from file start and every payload is `Alignment` aligned :
+ *
+ *   Header | Entry[entryCount] sorted by name | names | payloads
+ *
+ * Textures are stored decoded, fonts as their glyph atlas along with glyph metrics,
+ * so loading either is a single upload straight from mapped pages.
+ */
+namespace bundle {
+
+constexpr char Magic[8] = {'R', 'U', 'I', 'B', 'N', 'D', 'L', '\0'};
+constexpr std::uint32_t Version = 1;
+constexpr std::uint64_t Alignment = 16;
+
+// Same as DrawBackend::loadFont, so bundled and loose fonts render alike
+constexpr int FontBaseSize = 32;
+constexpr int FontGlyphCount = 95;
+constexpr int FontGlyphPadding = 4;
+
+enum class EntryKind : std::uint32_t {
+    Texture = 1,
+    Font = 2
+};
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint64_t entriesOffset;
+    std::uint64_t fileSize; // truncated bundles are rejected
+};
+
+struct Entry {
+    EntryKind kind;
+    std::uint32_t nameLength;
+    std::uint64_t nameOffset;
+    std::uint64_t dataOffset;
+    std::uint64_t dataSize;
+};
+
+// Followed by pixels (raylib pixel format, single mipmap)
+struct TextureHeader {
+    std::int32_t width;
+    std::int32_t height;
+    std::int32_t format;
+    std::int32_t mipmaps;
+};
+
+// Followed by `glyphCount` GlyphRecord then atlas pixels
+struct FontHeader {
+    std::int32_t baseSize;
+    std::int32_t glyphCount;
+    std::int32_t glyphPadding;
+    std::int32_t reserved;
+    TextureHeader atlas;
+};
+
+// Codepoint and metrics of a glyph, along with its rectangle in the atlas
+struct GlyphRecord {
+    std::int32_t value;
+    std::int32_t offsetX;
+    std::int32_t offsetY;
+    std::int32_t advanceX;
+    float x;
+    float y;
+    float width;
+    float height;
+};
+
+static_assert(sizeof(Header) % Alignment == 0 && sizeof(Entry) % 8 == 0);
+static_assert(sizeof(TextureHeader) % Alignment == 0 && sizeof(FontHeader) % Alignment == 0 && sizeof(GlyphRecord) % Alignment == 0);
+
+} // namespace bundle
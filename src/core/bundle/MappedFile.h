@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace bundle {
+
+/**
+ * Read-only memory mapping of a whole file, pages are only read once touched.
+ * Kept apart from raylib headers, which clash with the Windows API.
+ */
+class MappedFile {
+    const std::byte *_data;
+    std::size_t _size;
+#ifdef _WIN32
+    void *_file;
+    void *_mapping;
+#endif
+
+    void close();
+
+  public:
+    // Check `isOpen` for failure
+    explicit MappedFile(const std::filesystem::path &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool isOpen() const;
+
+    const std::byte *data() const;
+    std::size_t size() const;
+};
+
+} // namespace bundle
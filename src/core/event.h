@@ -1,4 +1,9 @@
 #pragma once
 
 #include "./event/Event.h"
-#include "./event/EventManager.h"
\ No newline at end of file
+#include "./event/EventDispatcher.h"
+#include "./event/EventListeners.h"
+#include "./event/EventManager.h"
+#include "./event/HoverTracker.h"
+#include "./event/InputFrame.h"
+#include "./event/InputRecording.h"
\ No newline at end of file
@@ -32,6 +32,30 @@ void Event::stopPropagation() {
     _stopPropagationFlag = true;
 }
 
+bool Event::isPropagationStopped() const {
+    return _stopPropagationFlag;
+}
+
+bool Event::isImmediatePropagationStopped() const {
+    return _stopImmediatePropagationFlag;
+}
+
+bool Event::bubbles() const {
+    return !isOfType<event::data::MouseEnter>() && !isOfType<event::data::MouseLeave>();
+}
+
+std::size_t Event::getTypeIndex() const {
+    return _data.index();
+}
+
+Event::Phase Event::getPhase() const {
+    return _phase;
+}
+
+void Event::setPhase(Phase phase) {
+    _phase = phase;
+}
+
 void Event::setTarget(std::shared_ptr<ui::element::Element> target) {
     _target = target;
 }
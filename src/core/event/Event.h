@@ -18,13 +18,54 @@ struct IsInVariant : std::false_type {};
 template <typename T, typename... Types>
 struct IsInVariant<T, std::variant<Types...>> : std::disjunction<std::is_same<T, Types>...> {};
 
+template <typename T, typename OtherType>
+struct VariantIndex;
+
+template <typename T, typename... Types>
+struct VariantIndex<T, std::variant<T, Types...>> : std::integral_constant<std::size_t, 0> {};
+
+template <typename T, typename U, typename... Types>
+struct VariantIndex<T, std::variant<U, Types...>>
+    : std::integral_constant<std::size_t, 1 + VariantIndex<T, std::variant<Types...>>::value> {};
+
 namespace event {
 
 class Event {
+    using EventData = std::variant<
+        event::data::MouseDown,
+        event::data::MouseUp,
+        event::data::Click,
+        event::data::DoubleClick,
+        event::data::MouseMove,
+        event::data::MouseLeave,
+        event::data::MouseEnter,
+        event::data::MouseOut,
+        event::data::MouseOver,
+        event::data::MouseWheel,
+        event::data::KeyDown,
+        event::data::KeyUp>;
+
   public:
+    enum class Phase {
+        None,
+        Capturing,
+        AtTarget,
+        Bubbling
+    };
+
+    template <typename T>
+    static constexpr bool isEventSubtype = IsInVariant<T, EventData>::value;
+
+    // Number of event subtypes, used to size type-indexed tables
+    static constexpr std::size_t TypeCount = std::variant_size_v<EventData>;
+
+    template <typename T>
+    static constexpr std::size_t TypeIndexOf = VariantIndex<T, EventData>::value;
+
     template <typename EventType>
     Event(EventType &&eventData) {
         _data = eventData;
+        _phase = Phase::None;
         _stopPropagationFlag = false;
         _stopImmediatePropagationFlag = false;
     }
@@ -64,29 +105,24 @@ class Event {
     // Prevents other handlers on the same element from firing
     void stopImmediatePropagation();
 
+    bool isPropagationStopped() const;
+    bool isImmediatePropagationStopped() const;
+
+    // `MouseEnter` and `MouseLeave` do not bubble
+    bool bubbles() const;
+
+    // Index of the carried data type, see `TypeIndexOf`
+    std::size_t getTypeIndex() const;
+
+    Phase getPhase() const;
+
     std::shared_ptr<ui::element::Element> getCurrentTarget() const;
     std::shared_ptr<ui::element::Element> getTarget() const;
 
     std::string getName() const;
 
   private:
-    using EventData = std::variant<
-        event::data::MouseDown,
-        event::data::MouseUp,
-        event::data::Click,
-        event::data::DoubleClick,
-        event::data::MouseMove,
-        event::data::MouseLeave,
-        event::data::MouseEnter,
-        event::data::MouseOut,
-        event::data::MouseOver,
-        event::data::MouseWheel,
-        event::data::KeyDown,
-        event::data::KeyUp>;
-
-    template <typename T>
-    static constexpr bool isEventSubtype = IsInVariant<T, EventData>::value;
-
+    void setPhase(Phase phase);
     void setCurrentTarget(std::shared_ptr<ui::element::Element> target);
     void setTarget(std::shared_ptr<ui::element::Element> target);
 
@@ -94,12 +130,14 @@ class Event {
     static const std::string subtypeNames[];
 
     EventData _data;
+    Phase _phase;
     bool _stopImmediatePropagationFlag;
     bool _stopPropagationFlag;
     std::weak_ptr<ui::element::Element> _currentTarget;
     std::weak_ptr<ui::element::Element> _target;
 
     friend class EventManager;
+    friend class EventDispatcher;
 };
 
 } // namespace event
\ No newline at end of file
@@ -0,0 +1,224 @@
+#include "./EventDispatcher.h"
+#include "./EventListeners.h"
+#include "../../utils/functions.h"
+
+#include <optional>
+#include <stack>
+#include <tuple>
+#include <vector>
+
+namespace event {
+
+namespace {
+
+bool clipsChildren(const ui::element::Element &element) {
+    const auto overflow = element.getLayout().overflow;
+    return overflow && *overflow != ui::style::Overflow::Visible;
+}
+
+// `point` in the untransformed layout space of `element`, whose box is `rect` once placed.
+// Nothing if element is scaled down to nothing
+std::optional<Vector2> toLocal(const ui::element::Element &element, const Rectangle &rect, const Vector2 &point) {
+    const auto transform = element.getResolvedTransform();
+    if (!transform)
+        return point;
+    if (transform->scale.x == 0 || transform->scale.y == 0)
+        return std::nullopt;
+
+    const Vector2 origin{rect.x + transform->origin.x, rect.y + transform->origin.y};
+    return utils::inverseTransformPoint(point, origin, transform->rotation, transform->scale, transform->translation);
+}
+
+// `point` in the layout space `element` is placed in, walking ancestors transforms from root.
+// Nothing if an ancestor clips it away
+std::optional<Vector2> toParentSpace(const std::shared_ptr<ui::element::Element> &element, Vector2 point) {
+    std::vector<std::shared_ptr<ui::element::Element>> ancestors;
+    for (auto parent = element->getParent(); parent; parent = parent->getParent())
+        ancestors.push_back(parent);
+
+    Vector2 origin{0.0, 0.0};
+    for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
+        auto rect = (*it)->getBoundingRect();
+        rect.x += origin.x;
+        rect.y += origin.y;
+
+        const auto local = toLocal(**it, rect, point);
+        if (!local || (clipsChildren(**it) && !CheckCollisionPointRec(*local, rect)))
+            return std::nullopt;
+
+        point = *local;
+        origin = Vector2{rect.x, rect.y};
+    }
+
+    return point;
+}
+
+// Topmost element of `ctx` (not considering its child contexts) under `point`.
+// Transforms are inverted rather than applied to boxes, overflowing content is clipped
+std::shared_ptr<ui::element::Element> hitTestContext(std::shared_ptr<ui::rendering::StackingContext> ctx, const Vector2 &point) {
+    auto owner = ctx->getOwner();
+    if (!owner || owner->isNotDisplayed())
+        return nullptr;
+
+    const auto ownerPoint = toParentSpace(owner, point);
+    if (!ownerPoint)
+        return nullptr;
+
+    // Elements are painted in pre-order with last child first (see StackingContext::render),
+    // walking in post-order with first child first gives the reverse paint order.
+    // [element, parent origin, point in parent space, visited]
+    std::stack<std::tuple<std::shared_ptr<ui::element::Element>, Vector2, Vector2, bool>> stack;
+    stack.push({owner, EventDispatcher::GetAbsoluteOrigin(owner), *ownerPoint, false});
+
+    while (!stack.empty()) {
+        auto [e, origin, parentPoint, visited] = stack.top();
+        stack.pop();
+
+        auto rect = e->getBoundingRect();
+        rect.x += origin.x;
+        rect.y += origin.y;
+
+        const auto local = toLocal(*e, rect, parentPoint);
+        if (!local)
+            continue;
+
+        if (visited) {
+            if (CheckCollisionPointRec(*local, rect))
+                return e;
+            continue;
+        }
+
+        stack.push({e, origin, parentPoint, true});
+        if (clipsChildren(*e) && !CheckCollisionPointRec(*local, rect))
+            continue;
+
+        const auto children = e->getChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            auto child = *it;
+            if (!child->isNotDisplayed() && child->belongsTo(ctx))
+                stack.push({child, Vector2{rect.x, rect.y}, *local, false});
+        }
+    }
+
+    return nullptr;
+}
+
+void invokeListeners(Event &event, const std::shared_ptr<ui::element::Element> &element, bool capture) {
+    if (auto listeners = element->findEventListeners())
+        listeners->invoke(event, capture);
+}
+
+} // namespace
+
+std::shared_ptr<ui::element::Element> EventDispatcher::HitTest(std::shared_ptr<ui::rendering::StackingContext> rootCtx, const Vector2 &point) {
+    if (!rootCtx)
+        return nullptr;
+
+    // Child contexts are painted after their parent, lowest z-index first.
+    // Visit them in reverse : highest z-index child subtrees, then parent's own elements.
+    std::stack<std::pair<std::shared_ptr<ui::rendering::StackingContext>, bool>> stack;
+    stack.push({rootCtx, false});
+
+    while (!stack.empty()) {
+        auto [ctx, visited] = stack.top();
+        stack.pop();
+
+        if (visited) {
+            if (auto hit = hitTestContext(ctx, point))
+                return hit;
+            continue;
+        }
+
+        stack.push({ctx, true});
+
+        const auto children = ctx->getChildren(); // sorted by decreasing z-index
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+            stack.push({*it, false});
+    }
+
+    return nullptr;
+}
+
+Vector2 EventDispatcher::GetAbsoluteOrigin(std::shared_ptr<const ui::element::Element> element) {
+    Vector2 origin{0.0, 0.0};
+    if (!element)
+        return origin;
+
+    for (auto parent = element->getParent(); parent; parent = parent->getParent()) {
+        const auto rect = parent->getBoundingRect();
+        origin.x += rect.x;
+        origin.y += rect.y;
+    }
+
+    return origin;
+}
+
+void EventDispatcher::BuildPath(std::shared_ptr<ui::element::Element> target, Path &path) {
+    path.clear();
+    for (auto e = target; e; e = e->getParent())
+        path.push_back(e);
+}
+
+void EventDispatcher::Dispatch(std::shared_ptr<Event> event, std::shared_ptr<ui::element::Element> target) {
+    if (!event || !target)
+        return;
+
+    Path path;
+    BuildPath(target, path);
+    Dispatch(event, path);
+}
+
+template <typename PathAccessor>
+void EventDispatcher::Propagate(Event &event, PathAccessor &&at, std::size_t size) {
+    const auto &target = at(0);
+    event.setTarget(target);
+
+    // capturing phase : root -> target's parent
+    event.setPhase(Event::Phase::Capturing);
+    for (auto i = size - 1; i > 0; --i) {
+        event.setCurrentTarget(at(i));
+        invokeListeners(event, at(i), true);
+
+        if (event.isPropagationStopped())
+            return;
+    }
+
+    // at target : capturing listeners first
+    event.setPhase(Event::Phase::AtTarget);
+    event.setCurrentTarget(target);
+    invokeListeners(event, target, true);
+    if (!event.isImmediatePropagationStopped())
+        invokeListeners(event, target, false);
+
+    if (event.isPropagationStopped() || !event.bubbles())
+        return;
+
+    // bubbling phase : target's parent -> root
+    event.setPhase(Event::Phase::Bubbling);
+    for (std::size_t i = 1; i < size; ++i) {
+        event.setCurrentTarget(at(i));
+        invokeListeners(event, at(i), false);
+
+        if (event.isPropagationStopped())
+            return;
+    }
+}
+
+void EventDispatcher::Dispatch(std::shared_ptr<Event> event, const Path &path) {
+    if (!event || path.empty())
+        return;
+
+    Propagate(*event, [&path](std::size_t i) -> const std::shared_ptr<ui::element::Element> & { return path[i]; }, path.size());
+    event->setPhase(Event::Phase::None);
+}
+
+void EventDispatcher::DispatchAlong(std::shared_ptr<Event> event, std::span<const std::shared_ptr<ui::element::Element>> rootFirstPath) {
+    if (!event || rootFirstPath.empty())
+        return;
+
+    const auto last = rootFirstPath.size() - 1;
+    Propagate(*event, [&](std::size_t i) -> const std::shared_ptr<ui::element::Element> & { return rootFirstPath[last - i]; }, rootFirstPath.size());
+    event->setPhase(Event::Phase::None);
+}
+
+} // namespace event
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "./Event.h"
+
+#include <elements/Element.h>
+#include <rendering/StackingContext.h>
+
+#include "../../utils/containers.h"
+
+#include <memory>
+#include <span>
+
+namespace event {
+
+class EventDispatcher {
+    // @param at Accessor returning path element, index 0 being the target
+    template <typename PathAccessor>
+    static void Propagate(Event &event, PathAccessor &&at, std::size_t size);
+
+  public:
+    // Target first, root last. Most trees are shallower than the inline capacity.
+    using Path = utils::InlineVector<std::shared_ptr<ui::element::Element>, 32>;
+
+    // Returns topmost displayed element under `point` (absolute position),
+    // following stacking contexts paint order. nullptr if none.
+    static std::shared_ptr<ui::element::Element> HitTest(std::shared_ptr<ui::rendering::StackingContext> rootCtx, const Vector2 &point);
+
+    // Fill `path` with `target` and its ancestors
+    static void BuildPath(std::shared_ptr<ui::element::Element> target, Path &path);
+
+    // Run capture, target and bubble phases along `target` ancestors
+    static void Dispatch(std::shared_ptr<Event> event, std::shared_ptr<ui::element::Element> target);
+
+    // Same as `Dispatch` with an already resolved path
+    static void Dispatch(std::shared_ptr<Event> event, const Path &path);
+
+    // Same as `Dispatch` with a cached path ordered from root to target
+    static void DispatchAlong(std::shared_ptr<Event> event, std::span<const std::shared_ptr<ui::element::Element>> rootFirstPath);
+
+    // Absolute layout position of `element`'s parent content box origin, transforms ignored
+    static Vector2 GetAbsoluteOrigin(std::shared_ptr<const ui::element::Element> element);
+};
+
+} // namespace event
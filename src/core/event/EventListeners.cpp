@@ -0,0 +1,63 @@
+#include "./EventListeners.h"
+
+#include <algorithm>
+
+event::EventListeners::ListenerId event::EventListeners::nextId = 0;
+
+namespace event {
+
+void EventListeners::remove(ListenerId id) {
+    for (auto &listeners : _listeners) {
+        auto it = std::find_if(listeners.begin(), listeners.end(), [id](const Listener &listener) {
+            return listener.id == id;
+        });
+
+        if (it == listeners.end())
+            continue;
+
+        if (_dispatchDepth > 0) { // do not invalidate iteration
+            it->callback = nullptr;
+            _hasRemovedListeners = true;
+        } else
+            listeners.erase(it);
+
+        return;
+    }
+}
+
+bool EventListeners::empty() const {
+    return std::all_of(_listeners.begin(), _listeners.end(), [](const auto &listeners) {
+        return listeners.empty();
+    });
+}
+
+void EventListeners::compact() {
+    for (auto &listeners : _listeners) {
+        listeners.erase(std::remove_if(listeners.begin(), listeners.end(), [](const Listener &listener) {
+                            return !listener.callback;
+                        }),
+                        listeners.end());
+    }
+
+    _hasRemovedListeners = false;
+}
+
+void EventListeners::invoke(Event &event, bool capture) {
+    auto &listeners = _listeners[event.getTypeIndex()];
+    const auto count = listeners.size();
+
+    ++_dispatchDepth;
+    for (std::size_t i = 0; i < count && !event.isImmediatePropagationStopped(); ++i) {
+        // copy : callback may add listeners and reallocate the vector
+        if (listeners[i].capture == capture && listeners[i].callback) {
+            auto callback = listeners[i].callback;
+            callback(event);
+        }
+    }
+    --_dispatchDepth;
+
+    if (_dispatchDepth == 0 && _hasRemovedListeners)
+        compact();
+}
+
+} // namespace event
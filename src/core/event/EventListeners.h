@@ -0,0 +1,56 @@
+#pragma once
+
+#include "./Event.h"
+
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace event {
+
+/**
+ * Per-element listener table.
+ * Listeners are grouped by event subtype index so dispatching an event only
+ * indexes an array, no name or hash lookup involved.
+ */
+class EventListeners {
+  public:
+    using ListenerId = unsigned int;
+    using Callback = std::function<void(Event &)>;
+
+  private:
+    struct Listener {
+        ListenerId id;
+        Callback callback; // reset when removed during dispatch
+        bool capture;
+    };
+
+    static ListenerId nextId;
+
+    std::array<std::vector<Listener>, Event::TypeCount> _listeners;
+    unsigned int _dispatchDepth = 0;
+    bool _hasRemovedListeners = false;
+
+    void compact();
+
+  public:
+    // @param capture Invoke during capturing phase instead of bubbling phase
+    template <typename EventType>
+    ListenerId add(Callback callback, bool capture = false) {
+        static_assert(Event::isEventSubtype<EventType>, "[EventListeners] Unknown event type");
+
+        const auto id = nextId++;
+        _listeners[Event::TypeIndexOf<EventType>].push_back(Listener{id, std::move(callback), capture});
+        return id;
+    }
+
+    void remove(ListenerId id);
+
+    bool empty() const;
+
+    // Invoke listeners registered for `event` type and phase.
+    // Listeners added while invoking are not called for the current event.
+    void invoke(Event &event, bool capture);
+};
+
+} // namespace event
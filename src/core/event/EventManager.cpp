@@ -1,13 +1,64 @@
 #include "./EventManager.h"
+#include "./EventDispatcher.h"
+
+#include <rendering/backend/DrawBackend.h>
 
 namespace event {
 
-EventManager::EventManager(std::shared_ptr<ui::element::Element> root) : _root(root) {
+EventManager::EventManager(std::shared_ptr<ui::element::Element> root)
+    : _root(root), _time(0), _keepCoalescedSamples(false), _currentSamples(0, 0), _input{}, _windowResized(false), _replayFinished(false) {
     // _rootLayer = _root->getLayer();
+    _cache.mousePosition = GetMousePosition();
+    _input.mousePosition = _cache.mousePosition;
+    _input.windowWidth = ui::rendering::backend::DrawBackend::Get().getScreenWidth();
+    _input.windowHeight = ui::rendering::backend::DrawBackend::Get().getScreenHeight();
 }
 
 void EventManager::update(std::uint64_t dt) {
-    const auto mousePosition = GetMousePosition();
+    InputFrame frame;
+
+    if (_replayer) {
+        if (!_replayer->next(frame)) {
+            TraceLog(LOG_INFO, "[EventManager] Input replay finished after %llu frames", (unsigned long long)_input.frame);
+            _replayer.reset();
+            _replayFinished = true;
+            return;
+        }
+    } else if (_replayFinished) {
+        return; // window input stays ignored once a replay has run
+    } else
+        frame = captureInputFrame(dt);
+
+    if (_recorder)
+        _recorder->write(frame);
+
+    processInputFrame(frame);
+}
+
+void EventManager::update(const InputFrame &frame) {
+    if (_replayer || _replayFinished) {
+        update(frame.dt);
+        return;
+    }
+
+    auto input = frame;
+    input.frame = _input.frame + 1;
+    if (_recorder)
+        _recorder->write(input);
+
+    processInputFrame(input);
+}
+
+InputFrame EventManager::captureInputFrame(std::uint64_t dt) {
+    auto frame = _sampler.sample(dt);
+    frame.frame = _input.frame + 1;
+    return frame;
+}
+
+void EventManager::processInputFrame(const InputFrame &frame) {
+    _time += frame.dt;
+
+    const auto mousePosition = frame.mousePosition;
     const std::vector<MouseButton> mouseButtons = {
         MOUSE_BUTTON_BACK,
         MOUSE_BUTTON_EXTRA,
@@ -17,16 +68,227 @@ void EventManager::update(std::uint64_t dt) {
         MOUSE_BUTTON_RIGHT,
         MOUSE_BUTTON_SIDE};
 
+    if (mousePosition != _cache.mousePosition) {
+        const Vector2 movement{mousePosition.x - _cache.mousePosition.x, mousePosition.y - _cache.mousePosition.y};
+        _events.emplace_back(Event::New(event::data::MouseMove{mousePosition, movement}));
+    }
+
+    if (frame.wheel.x != 0.0 || frame.wheel.y != 0.0)
+        _events.emplace_back(Event::New(event::data::MouseWheel{mousePosition, frame.wheel}));
+
     for (auto button : mouseButtons) {
-        if (IsMouseButtonPressed(button))
+        const auto wasDown = _input.isMouseButtonDown(button);
+        const auto isDown = frame.isMouseButtonDown(button);
+
+        if (isDown && !wasDown)
             _events.emplace_back(Event::New(event::data::MouseDown{mousePosition, button}));
 
-        if (IsMouseButtonReleased(button)) {
+        if (!isDown && wasDown) {
             _events.emplace_back(Event::New(event::data::MouseUp{mousePosition, button}));
         }
     }
 
+    auto &keysDown = _cache.keysDown;
+    for (const auto &[key, action] : frame.keys) {
+        switch (action) {
+        case InputFrame::KeyAction::Pressed:
+            _events.emplace_back(Event::New(event::data::KeyDown{key, false}));
+            keysDown.push_back(key);
+            break;
+
+        case InputFrame::KeyAction::Repeated:
+            _events.emplace_back(Event::New(event::data::KeyDown{key, true}));
+            break;
+
+        case InputFrame::KeyAction::Released:
+            _events.emplace_back(Event::New(event::data::KeyUp{key, false}));
+            std::erase(keysDown, key);
+            break;
+        }
+    }
+
+    _windowResized = frame.windowWidth != _input.windowWidth || frame.windowHeight != _input.windowHeight;
     _cache.mousePosition = mousePosition;
+    _input = frame;
+}
+
+bool EventManager::startRecording(const std::filesystem::path &path) {
+    _recorder = std::make_unique<InputRecorder>(path);
+    if (!_recorder->isOpen()) {
+        _recorder.reset();
+        return false;
+    }
+
+    TraceLog(LOG_INFO, "[EventManager] Recording input to %s", path.string().c_str());
+    return true;
+}
+
+void EventManager::stopRecording() {
+    _recorder.reset();
+}
+
+bool EventManager::isRecording() const {
+    return _recorder != nullptr;
+}
+
+bool EventManager::startReplay(const std::filesystem::path &path, std::uint32_t fixedDt) {
+    _replayer = std::make_unique<InputReplayer>(path, fixedDt);
+    if (!_replayer->isOpen()) {
+        _replayer.reset();
+        return false;
+    }
+
+    TraceLog(LOG_INFO, "[EventManager] Replaying input from %s", path.string().c_str());
+    _replayFinished = false;
+    return true;
+}
+
+bool EventManager::isReplaying() const {
+    return _replayer != nullptr;
+}
+
+bool EventManager::isReplayFinished() const {
+    return _replayFinished;
+}
+
+const InputFrame &EventManager::getInputFrame() const {
+    return _input;
+}
+
+bool EventManager::isWindowResized() const {
+    return _windowResized;
+}
+
+void EventManager::pushEvent(std::shared_ptr<Event> event) {
+    if (event)
+        _events.push_back(event);
+}
+
+void EventManager::setKeepCoalescedSamples(bool keep) {
+    _keepCoalescedSamples = keep;
+}
+
+std::span<const event::data::MouseMove> EventManager::getCoalescedSamples() const {
+    return std::span<const event::data::MouseMove>(_coalescedSamples).subspan(_currentSamples.first, _currentSamples.second - _currentSamples.first);
+}
+
+void EventManager::coalesceEvents() {
+    std::vector<std::shared_ptr<Event>> coalesced;
+    coalesced.reserve(_events.size());
+    _coalescedSamples.clear();
+    _sampleRanges.clear();
+
+    for (auto &event : _events) {
+        auto previous = coalesced.empty() ? nullptr : coalesced.back();
+
+        if (auto move = std::get_if<event::data::MouseMove>(&event->_data)) {
+            if (_keepCoalescedSamples)
+                _coalescedSamples.push_back(*move);
+
+            if (previous && previous->isOfType<event::data::MouseMove>()) {
+                auto &merged = std::get<event::data::MouseMove>(previous->_data);
+                merged.position = move->position;
+                merged.movement.x += move->movement.x;
+                merged.movement.y += move->movement.y;
+                _sampleRanges.back().second = _coalescedSamples.size();
+                continue;
+            }
+
+            coalesced.push_back(event);
+            _sampleRanges.emplace_back(_coalescedSamples.size() - (_keepCoalescedSamples ? 1 : 0), _coalescedSamples.size());
+            continue;
+        }
+
+        if (auto wheel = std::get_if<event::data::MouseWheel>(&event->_data)) {
+            if (previous && previous->isOfType<event::data::MouseWheel>()) {
+                auto &merged = std::get<event::data::MouseWheel>(previous->_data);
+                merged.position = wheel->position;
+                merged.delta.x += wheel->delta.x;
+                merged.delta.y += wheel->delta.y;
+                continue;
+            }
+        }
+
+        coalesced.push_back(event);
+        _sampleRanges.emplace_back(_coalescedSamples.size(), _coalescedSamples.size());
+    }
+
+    _events = std::move(coalesced);
+}
+
+void EventManager::dispatchEvents() {
+    coalesceEvents();
+
+    // handlers may queue new events
+    auto events = std::move(_events);
+    auto sampleRanges = std::move(_sampleRanges);
+    _events.clear();
+    _sampleRanges.clear();
+
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        _currentSamples = sampleRanges[i];
+        dispatch(events[i]);
+    }
+
+    _currentSamples = {0, 0};
+}
+
+std::shared_ptr<ui::element::Element> EventManager::getHovered() const {
+    return _cache.hover.getHovered();
+}
+
+std::shared_ptr<ui::element::Element> EventManager::resolveTarget(const Event &event) const {
+    std::optional<Vector2> position;
+    std::visit([&position](const auto &data) {
+        if constexpr (requires { data.position; })
+            position = data.position;
+    },
+               event._data);
+
+    // no focus handling yet : keyboard events go to the root
+    if (!position)
+        return _root;
+
+    auto target = EventDispatcher::HitTest(_root->getStackingContext(), *position);
+    return target ? target : _root;
+}
+
+void EventManager::dispatch(std::shared_ptr<Event> event) {
+    auto target = resolveTarget(*event);
+
+    if (auto mouseDown = event->getIf<event::data::MouseDown>())
+        _cache.pressedTargets[mouseDown->button] = target;
+
+    // hover transitions are notified before the move itself
+    if (auto mouseMove = event->getIf<event::data::MouseMove>())
+        _cache.hover.update(target, mouseMove->position);
+
+    EventDispatcher::Dispatch(event, target);
+
+    if (event->isOfType<event::data::MouseUp>())
+        synthesizeClicks(*event, target);
+}
+
+void EventManager::synthesizeClicks(const Event &mouseUp, std::shared_ptr<ui::element::Element> target) {
+    const auto data = mouseUp.unwrapData<event::data::MouseUp>();
+
+    auto pressed = _cache.pressedTargets.find(data.button);
+    if (pressed == _cache.pressedTargets.end())
+        return;
+
+    auto pressedTarget = pressed->second.lock();
+    _cache.pressedTargets.erase(pressed);
+    if (pressedTarget != target) // press and release on different elements
+        return;
+
+    EventDispatcher::Dispatch(Event::New(event::data::Click{data.position, data.button}), target);
+
+    auto lastClick = _cache.clickedTime.find(data.button);
+    if (lastClick != _cache.clickedTime.end() && _time - lastClick->second <= DoubleClickDelay) {
+        EventDispatcher::Dispatch(Event::New(event::data::DoubleClick{data.position, data.button}), target);
+        _cache.clickedTime.erase(lastClick);
+    } else
+        _cache.clickedTime[data.button] = _time;
 }
 
-} // namespace event
\ No newline at end of file
+} // namespace event
@@ -1,11 +1,17 @@
 #pragma once
 
 #include "./Event.h"
+#include "./HoverTracker.h"
+#include "./InputFrame.h"
+#include "./InputRecording.h"
+#include "./InputSampler.h"
 
 #include <elements/Element.h>
 #include <rendering/Layer.h>
 
+#include <filesystem>
 #include <memory>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -14,21 +20,95 @@ namespace event {
 class EventManager {
     struct Cache {
         Vector2 mousePosition;
-        std::shared_ptr<ui::element::Element> lastHovered;          // in context of `MouseLeave`, `MouseEnter`, `MouseOut` and `MouseOver`
-        std::unordered_map<MouseButton, std::uint64_t> clickedTime; // last click time in milliseconds
+        HoverTracker hover;                                                     // in context of `MouseLeave`, `MouseEnter`, `MouseOut` and `MouseOver`
+        std::unordered_map<MouseButton, std::uint64_t> clickedTime;             // last click time in milliseconds
+        std::unordered_map<MouseButton, std::weak_ptr<ui::element::Element>> pressedTargets; // `MouseDown` targets, used to detect clicks
+        std::vector<KeyboardKey> keysDown;
     };
 
+    // [begin, end[ range in `_coalescedSamples`
+    using SampleRange = std::pair<std::size_t, std::size_t>;
+
+    // Maximum delay between two clicks in milliseconds to be considered as a double click
+    static constexpr std::uint64_t DoubleClickDelay = 500;
+
     std::shared_ptr<ui::element::Element> _root;
     std::shared_ptr<ui::rendering::Layer> _rootLayer;
     std::vector<std::shared_ptr<Event>> _events;
+    std::uint64_t _time; // elapsed time in milliseconds
     Cache _cache;
+    bool _keepCoalescedSamples;
+    std::vector<event::data::MouseMove> _coalescedSamples;
+    std::vector<SampleRange> _sampleRanges; // one per cached event after coalescing
+    SampleRange _currentSamples;
+
+    InputFrame _input; // last processed input frame
+    InputSampler _sampler;
+    bool _windowResized;
+    std::unique_ptr<InputRecorder> _recorder;
+    std::unique_ptr<InputReplayer> _replayer;
+    bool _replayFinished;
+
+    // Poll raylib for current frame input
+    InputFrame captureInputFrame(std::uint64_t dt);
+
+    // Turn input state changes into events
+    void processInputFrame(const InputFrame &frame);
+
+    // Merge consecutive `MouseMove` and consecutive `MouseWheel` events,
+    // discrete events are left untouched and in order.
+    void coalesceEvents();
+
+    // Element an event should be dispatched to
+    std::shared_ptr<ui::element::Element> resolveTarget(const Event &event) const;
+
+    void dispatch(std::shared_ptr<Event> event);
+
+    // Emit `Click` and `DoubleClick` following a `MouseUp`
+    void synthesizeClicks(const Event &mouseUp, std::shared_ptr<ui::element::Element> target);
 
   public:
     EventManager(std::shared_ptr<ui::element::Element> root);
 
-    // Update cached events
-    // @param dt delta-time in milliseconds
+    // Update cached events from window input, or from the replayed stream if any
+    // @param dt delta-time in milliseconds, ignored while replaying
     void update(std::uint64_t dt);
+
+    // Update cached events from a frame sampled on the thread owning the window.
+    // A replay still takes precedence, `frame` being ignored
+    void update(const InputFrame &frame);
+
+    // Write every processed input frame to `path`
+    bool startRecording(const std::filesystem::path &path);
+    void stopRecording();
+    bool isRecording() const;
+
+    // Feed input frames from a recording instead of the window, frame by frame
+    // @param fixedDt Delta-time in milliseconds of every replayed frame
+    bool startReplay(const std::filesystem::path &path, std::uint32_t fixedDt = 16);
+    bool isReplaying() const;
+    bool isReplayFinished() const;
+
+    const InputFrame &getInputFrame() const;
+
+    // Window size changed during last update (also replayed)
+    bool isWindowResized() const;
+
+    // Queue an event produced outside of raylib polling (high-rate devices, tests, ...)
+    void pushEvent(std::shared_ptr<Event> event);
+
+    // Coalesce, dispatch and drain cached events.
+    // Handler invocations are bounded per frame whatever the input sample rate.
+    void dispatchEvents();
+
+    // Keep raw `MouseMove` samples merged into coalesced events (drawing apps, ...)
+    void setKeepCoalescedSamples(bool keep);
+
+    std::shared_ptr<ui::element::Element> getHovered() const;
+
+    // Raw samples merged into the `MouseMove` currently being dispatched.
+    // Empty unless `setKeepCoalescedSamples(true)` has been called.
+    std::span<const event::data::MouseMove> getCoalescedSamples() const;
 };
 
-} // namespace event
\ No newline at end of file
+} // namespace event
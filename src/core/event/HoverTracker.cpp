@@ -0,0 +1,73 @@
+#include "./HoverTracker.h"
+#include "./EventDispatcher.h"
+
+#include <span>
+
+namespace event {
+
+long HoverTracker::findDivergence(std::shared_ptr<ui::element::Element> element, std::vector<std::shared_ptr<ui::element::Element>> &branch) const {
+    for (auto e = element; e; e = e->getParent()) {
+        auto it = _depths.find(e->getId());
+        if (it != _depths.end() && _path[it->second] == e)
+            return it->second;
+
+        branch.push_back(e);
+    }
+
+    return -1;
+}
+
+bool HoverTracker::update(std::shared_ptr<ui::element::Element> hovered, const Vector2 &position) {
+    auto previous = getHovered();
+    if (hovered == previous)
+        return false;
+
+    std::vector<std::shared_ptr<ui::element::Element>> branch;
+    const auto divergence = findDivergence(hovered, branch);
+    const std::span<const std::shared_ptr<ui::element::Element>> oldPath(_path);
+
+    if (previous) {
+        EventDispatcher::DispatchAlong(Event::New(event::data::MouseOut{position, hovered}), oldPath);
+
+        // deepest first, up to the common ancestor (excluded)
+        for (long depth = long(_path.size()) - 1; depth > divergence; --depth)
+            EventDispatcher::DispatchAlong(Event::New(event::data::MouseLeave{position, hovered}), oldPath.first(depth + 1));
+    }
+
+    // swap left branch for the new one
+    for (auto depth = _path.size(); long(depth) - 1 > divergence; --depth) {
+        _depths.erase(_path.back()->getId());
+        _path.pop_back();
+    }
+
+    for (auto it = branch.rbegin(); it != branch.rend(); ++it) {
+        _depths[(*it)->getId()] = _path.size();
+        _path.push_back(*it);
+    }
+
+    if (hovered) {
+        const std::span<const std::shared_ptr<ui::element::Element>> newPath(_path);
+        EventDispatcher::DispatchAlong(Event::New(event::data::MouseOver{position, previous}), newPath);
+
+        // shallowest first
+        for (auto depth = _path.size() - branch.size(); depth < _path.size(); ++depth)
+            EventDispatcher::DispatchAlong(Event::New(event::data::MouseEnter{position, previous}), newPath.first(depth + 1));
+    }
+
+    return true;
+}
+
+std::shared_ptr<ui::element::Element> HoverTracker::getHovered() const {
+    return _path.empty() ? nullptr : _path.back();
+}
+
+const std::vector<std::shared_ptr<ui::element::Element>> &HoverTracker::getPath() const {
+    return _path;
+}
+
+void HoverTracker::reset() {
+    _path.clear();
+    _depths.clear();
+}
+
+} // namespace event
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "./Event.h"
+
+#include <elements/Element.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace event {
+
+/**
+ * Emits `MouseOut`, `MouseLeave`, `MouseOver` and `MouseEnter` when the hovered element changes.
+ * The hovered path is cached so only the branch between the divergence point
+ * and the new hovered element is walked : cost is proportional to the depth change.
+ */
+class HoverTracker {
+    std::vector<std::shared_ptr<ui::element::Element>> _path;           // root first, hovered element last
+    std::unordered_map<ui::element::Element::ElementId, std::size_t> _depths; // index in `_path` of each hovered element
+
+    // Index in `_path` of the deepest ancestor of `element` (itself included) still hovered.
+    // Fills `branch` with the elements walked before reaching it, deepest first.
+    // @return -1 if no ancestor is part of current path
+    long findDivergence(std::shared_ptr<ui::element::Element> element, std::vector<std::shared_ptr<ui::element::Element>> &branch) const;
+
+  public:
+    // Nothing is done if `hovered` is already the hovered element
+    // @return `true` if hovered element changed
+    bool update(std::shared_ptr<ui::element::Element> hovered, const Vector2 &position);
+
+    std::shared_ptr<ui::element::Element> getHovered() const;
+
+    // Root first, hovered element last
+    const std::vector<std::shared_ptr<ui::element::Element>> &getPath() const;
+
+    // Drop hovered path without emitting any event
+    void reset();
+};
+
+} // namespace event
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace event {
+
+// Raw input state sampled once per frame, either polled from the window or replayed
+struct InputFrame {
+    enum class KeyAction : std::uint8_t {
+        Pressed,
+        Repeated,
+        Released
+    };
+
+    struct KeyTransition {
+        KeyboardKey key;
+        KeyAction action;
+    };
+
+    std::uint64_t frame;         // frame index since recording/replay start
+    std::uint32_t dt;            // delta-time in milliseconds
+    Vector2 mousePosition;       // absolute position
+    Vector2 wheel;               // scroll amount during this frame
+    std::uint8_t mouseButtons;   // bit `MouseButton` set while button is held
+    int windowWidth;
+    int windowHeight;
+    std::vector<KeyTransition> keys; // in order of occurrence
+
+    bool isMouseButtonDown(MouseButton button) const {
+        return mouseButtons & (1u << button);
+    }
+};
+
+} // namespace event
@@ -0,0 +1,158 @@
+#include "./InputRecording.h"
+#include "../../utils/operators.h"
+
+#include <array>
+
+namespace event {
+
+namespace {
+
+constexpr std::array<char, 4> Magic = {'R', 'U', 'I', 'R'};
+constexpr std::uint16_t Version = 1;
+
+enum ChangedField : std::uint8_t {
+    MousePositionField = 1 << 0,
+    WheelField = 1 << 1,
+    MouseButtonsField = 1 << 2,
+    WindowSizeField = 1 << 3,
+    KeysField = 1 << 4
+};
+
+template <typename T>
+void writeValue(std::ofstream &output, const T &value) {
+    output.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::ifstream &input, T &value) {
+    return bool(input.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+} // namespace
+
+InputRecorder::InputRecorder(const std::filesystem::path &path)
+    : _output(path, std::ios::binary | std::ios::trunc), _previous{}, _first(true) {
+    if (!_output) {
+        TraceLog(LOG_ERROR, "[InputRecorder] Unable to open %s", path.string().c_str());
+        return;
+    }
+
+    _output.write(Magic.data(), Magic.size());
+    writeValue(_output, Version);
+}
+
+bool InputRecorder::isOpen() const {
+    return _output.is_open() && _output.good();
+}
+
+void InputRecorder::write(const InputFrame &frame) {
+    if (!isOpen())
+        return;
+
+    std::uint8_t changed = 0;
+    if (_first || frame.mousePosition != _previous.mousePosition)
+        changed |= MousePositionField;
+    if (frame.wheel.x != 0.0 || frame.wheel.y != 0.0)
+        changed |= WheelField;
+    if (_first || frame.mouseButtons != _previous.mouseButtons)
+        changed |= MouseButtonsField;
+    if (_first || frame.windowWidth != _previous.windowWidth || frame.windowHeight != _previous.windowHeight)
+        changed |= WindowSizeField;
+    if (!frame.keys.empty())
+        changed |= KeysField;
+
+    writeValue(_output, changed);
+    writeValue(_output, std::uint16_t(frame.dt));
+
+    if (changed & MousePositionField)
+        writeValue(_output, frame.mousePosition);
+    if (changed & WheelField)
+        writeValue(_output, frame.wheel);
+    if (changed & MouseButtonsField)
+        writeValue(_output, frame.mouseButtons);
+    if (changed & WindowSizeField) {
+        writeValue(_output, std::uint16_t(frame.windowWidth));
+        writeValue(_output, std::uint16_t(frame.windowHeight));
+    }
+    if (changed & KeysField) {
+        writeValue(_output, std::uint8_t(frame.keys.size()));
+        for (const auto &transition : frame.keys) {
+            writeValue(_output, std::uint16_t(transition.key));
+            writeValue(_output, transition.action);
+        }
+    }
+
+    _previous = frame;
+    _first = false;
+}
+
+InputReplayer::InputReplayer(const std::filesystem::path &path, std::uint32_t fixedDt)
+    : _input(path, std::ios::binary), _current{}, _frame(0), _fixedDt(fixedDt) {
+    if (!_input) {
+        TraceLog(LOG_ERROR, "[InputReplayer] Unable to open %s", path.string().c_str());
+        return;
+    }
+
+    std::array<char, 4> magic;
+    std::uint16_t version = 0;
+    _input.read(magic.data(), magic.size());
+    readValue(_input, version);
+
+    if (!_input || magic != Magic || version != Version) {
+        TraceLog(LOG_ERROR, "[InputReplayer] %s is not a supported input recording", path.string().c_str());
+        _input.close();
+    }
+}
+
+bool InputReplayer::isOpen() const {
+    return _input.is_open();
+}
+
+bool InputReplayer::next(InputFrame &frame) {
+    if (!isOpen())
+        return false;
+
+    std::uint8_t changed = 0;
+    std::uint16_t dt = 0;
+    if (!readValue(_input, changed) || !readValue(_input, dt))
+        return false;
+
+    _current.frame = _frame++;
+    _current.dt = _fixedDt;
+    _current.wheel = Vector2{0.0, 0.0};
+    _current.keys.clear();
+
+    bool ok = true;
+    if (changed & MousePositionField)
+        ok = ok && readValue(_input, _current.mousePosition);
+    if (changed & WheelField)
+        ok = ok && readValue(_input, _current.wheel);
+    if (changed & MouseButtonsField)
+        ok = ok && readValue(_input, _current.mouseButtons);
+    if (changed & WindowSizeField) {
+        std::uint16_t width = 0, height = 0;
+        ok = ok && readValue(_input, width) && readValue(_input, height);
+        _current.windowWidth = width;
+        _current.windowHeight = height;
+    }
+    if (changed & KeysField) {
+        std::uint8_t count = 0;
+        ok = ok && readValue(_input, count);
+        for (std::uint8_t i = 0; ok && i < count; ++i) {
+            std::uint16_t key = 0;
+            InputFrame::KeyAction action;
+            ok = readValue(_input, key) && readValue(_input, action);
+            _current.keys.push_back({static_cast<KeyboardKey>(key), action});
+        }
+    }
+
+    if (!ok) {
+        TraceLog(LOG_WARNING, "[InputReplayer] Truncated input recording");
+        return false;
+    }
+
+    frame = _current;
+    return true;
+}
+
+} // namespace event
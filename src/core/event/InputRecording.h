@@ -0,0 +1,46 @@
+#pragma once
+
+#include "./InputFrame.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace event {
+
+/**
+ * Binary input stream layout (host endianness) :
+ *   header : "RUIR" magic, u16 version
+ *   frames : u8 changed-fields mask, u16 dt, then only the fields flagged as changed
+ *            since previous frame (position, wheel, buttons, window size, key transitions)
+ * An idle frame takes 3 bytes.
+ */
+class InputRecorder {
+    std::ofstream _output;
+    InputFrame _previous;
+    bool _first;
+
+  public:
+    InputRecorder(const std::filesystem::path &path);
+
+    bool isOpen() const;
+
+    void write(const InputFrame &frame);
+};
+
+class InputReplayer {
+    std::ifstream _input;
+    InputFrame _current;
+    std::uint64_t _frame;
+    std::uint32_t _fixedDt;
+
+  public:
+    // @param fixedDt Delta-time in milliseconds reported for every replayed frame
+    InputReplayer(const std::filesystem::path &path, std::uint32_t fixedDt);
+
+    bool isOpen() const;
+
+    // @return `false` once the stream is exhausted
+    bool next(InputFrame &frame);
+};
+
+} // namespace event
@@ -0,0 +1,36 @@
+#include "./InputSampler.h"
+
+#include <rendering/backend/DrawBackend.h>
+
+namespace event {
+
+InputFrame InputSampler::sample(std::uint32_t dt) {
+    InputFrame frame{};
+    frame.dt = dt;
+    frame.mousePosition = GetMousePosition();
+    frame.wheel = GetMouseWheelMoveV();
+    frame.windowWidth = ui::rendering::backend::DrawBackend::Get().getScreenWidth();
+    frame.windowHeight = ui::rendering::backend::DrawBackend::Get().getScreenHeight();
+
+    for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_BACK; ++button) {
+        if (IsMouseButtonDown(button))
+            frame.mouseButtons |= 1u << button;
+    }
+
+    for (auto key : _keysDown) {
+        if (IsKeyReleased(key))
+            frame.keys.push_back({key, InputFrame::KeyAction::Released});
+        else if (IsKeyPressedRepeat(key))
+            frame.keys.push_back({key, InputFrame::KeyAction::Repeated});
+    }
+    std::erase_if(_keysDown, [](KeyboardKey key) { return IsKeyReleased(key); });
+
+    for (int key = GetKeyPressed(); key != 0; key = GetKeyPressed()) {
+        frame.keys.push_back({static_cast<KeyboardKey>(key), InputFrame::KeyAction::Pressed});
+        _keysDown.push_back(static_cast<KeyboardKey>(key));
+    }
+
+    return frame;
+}
+
+} // namespace event
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "./InputFrame.h"
+
+#include <vector>
+
+namespace event {
+
+// Polls window input into frames, must run on the thread owning the window
+class InputSampler {
+    std::vector<KeyboardKey> _keysDown; // to report releases and repeats
+
+  public:
+    // `frame` index is left to the consumer
+    InputFrame sample(std::uint32_t dt);
+};
+
+} // namespace event
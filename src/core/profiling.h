@@ -0,0 +1,4 @@
+#pragma once
+
+#include "./profiling/Profiler.h"
+#include "./profiling/Tracer.h"
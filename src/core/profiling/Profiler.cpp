@@ -0,0 +1,110 @@
+#include "./Profiler.h"
+
+#include <algorithm>
+#include <format>
+
+namespace profiling {
+
+Profiler::Profiler() : _publishedFrames(0), _current{}, _frameStart(Clock::now()), _enabled(true) {}
+
+void Profiler::setEnabled(bool enabled) {
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::endFrame() {
+    const auto now = Clock::now();
+    const auto frame = _publishedFrames.load(std::memory_order_relaxed);
+    auto &slot = _slots[frame % Capacity];
+
+    const auto sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.frame.store(frame, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < PhaseCount; ++i)
+        slot.phases[i].store(_current[i], std::memory_order_relaxed);
+    slot.total.store(std::chrono::duration_cast<std::chrono::microseconds>(now - _frameStart).count(), std::memory_order_relaxed);
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+    _publishedFrames.store(frame + 1, std::memory_order_release);
+
+    _current.fill(0);
+    _frameStart = now;
+
+    Tracer::Get().instant("Frame", "frame");
+}
+
+std::uint64_t Profiler::getFrameCount() const {
+    return _publishedFrames.load(std::memory_order_acquire);
+}
+
+std::vector<FrameTimings> Profiler::getFrames() const {
+    const auto published = getFrameCount();
+    const auto count = std::min<std::uint64_t>(published, Capacity);
+
+    std::vector<FrameTimings> frames;
+    frames.reserve(count);
+
+    for (auto frame = published - count; frame < published; ++frame) {
+        const auto &slot = _slots[frame % Capacity];
+        FrameTimings timings;
+        std::uint64_t before, after;
+
+        do { // retry while the writer is overwriting this slot
+            before = slot.sequence.load(std::memory_order_acquire);
+            timings.frame = slot.frame.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < PhaseCount; ++i)
+                timings.phases[i] = slot.phases[i].load(std::memory_order_relaxed);
+            timings.total = slot.total.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = slot.sequence.load(std::memory_order_relaxed);
+        } while (before != after || (before & 1));
+
+        // slot has already been reused for a newer frame
+        if (timings.frame == frame)
+            frames.push_back(timings);
+    }
+
+    return frames;
+}
+
+std::array<PhaseStats, PhaseCount + 1> Profiler::getStats() const {
+    std::array<PhaseStats, PhaseCount + 1> stats{};
+    const auto frames = getFrames();
+    if (frames.empty())
+        return stats;
+
+    std::vector<std::uint32_t> samples(frames.size());
+
+    for (std::size_t phase = 0; phase <= PhaseCount; ++phase) {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            samples[i] = phase < PhaseCount ? frames[i].phases[phase] : frames[i].total;
+            sum += samples[i];
+        }
+
+        const auto p99Index = std::min(samples.size() - 1, samples.size() * 99 / 100);
+        std::nth_element(samples.begin(), samples.begin() + p99Index, samples.end());
+
+        stats[phase] = PhaseStats{
+            .min = *std::min_element(samples.begin(), samples.end()) / 1000.0f,
+            .avg = float(sum) / samples.size() / 1000.0f,
+            .p99 = samples[p99Index] / 1000.0f};
+    }
+
+    return stats;
+}
+
+std::string Profiler::report() const {
+    const auto stats = getStats();
+    std::string output = std::format("{:<10} {:>8} {:>8} {:>8}\n", "phase (ms)", "min", "avg", "p99");
+
+    for (std::size_t phase = 0; phase <= PhaseCount; ++phase) {
+        const auto &s = stats[phase];
+        output += std::format("{:<10} {:>8.3f} {:>8.3f} {:>8.3f}\n", GetPhaseName(static_cast<Phase>(phase)), s.min, s.avg, s.p99);
+    }
+
+    return output;
+}
+
+} // namespace profiling
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "./Tracer.h"
+
+// Zones only exist when built with RETAINED_UI_PROFILING (defines UI_PROFILING)
+#ifdef UI_PROFILING
+#define PROFILE_PHASE(phase)                                                  \
+    ::profiling::ScopedZone PROFILING_CONCAT(profilingZone, __LINE__)(phase); \
+    ::profiling::TraceZone PROFILING_CONCAT(traceZone, __LINE__)(::profiling::GetPhaseName(phase), "frame")
+#define PROFILE_FRAME_END() ::profiling::Profiler::Get().endFrame()
+#else
+#define PROFILE_PHASE(phase) ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#endif
+
+namespace profiling {
+
+// Frame pipeline phases
+enum class Phase : std::uint8_t {
+    Events,    // input polling and event dispatch
+    Layout,    // Root::calculateLayout
+    Styles,    // inheritable styles propagation
+    Paint,     // StackingContext::renderTree
+    Composite, // Layer::composite and root layer render
+    Present,   // EndDrawing (buffer swap, input polling)
+    Animation, // animation frame callbacks and tasks
+    Idle,      // idle callbacks within what is left of frame budget
+    Count
+};
+
+constexpr std::size_t PhaseCount = static_cast<std::size_t>(Phase::Count);
+
+inline const char *GetPhaseName(Phase phase) {
+    constexpr const char *names[] = {"Events", "Layout", "Styles", "Paint", "Composite", "Present", "Animation", "Idle"};
+    const auto index = static_cast<std::size_t>(phase);
+    return index < PhaseCount ? names[index] : "Frame";
+}
+
+struct PhaseStats {
+    float min; // milliseconds
+    float avg;
+    float p99;
+};
+
+struct FrameTimings {
+    std::uint64_t frame;
+    std::array<std::uint32_t, PhaseCount> phases; // microseconds
+    std::uint32_t total;                           // microseconds, whole frame
+};
+
+/**
+ * Collects per-phase timings of the last `Capacity` frames.
+ * Zones are recorded from the UI thread, frames are published into a ring buffer
+ * which can be read from any thread without locking (per slot sequence counters).
+ */
+class Profiler {
+  public:
+    static constexpr std::size_t Capacity = 240;
+
+    using Clock = std::chrono::steady_clock;
+
+  private:
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0}; // odd while being written
+        std::atomic<std::uint64_t> frame{0};
+        std::array<std::atomic<std::uint32_t>, PhaseCount> phases{};
+        std::atomic<std::uint32_t> total{0};
+    };
+
+    std::array<Slot, Capacity> _slots;
+    std::atomic<std::uint64_t> _publishedFrames;
+    std::array<std::uint32_t, PhaseCount> _current; // accumulated for the frame in progress
+    Clock::time_point _frameStart;
+    std::atomic<bool> _enabled;
+
+    Profiler();
+
+  public:
+    static Profiler &Get() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    bool isEnabled() const {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool enabled);
+
+    void record(Phase phase, Clock::duration duration) {
+        _current[static_cast<std::size_t>(phase)] += std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    }
+
+    // Publish the frame in progress and start a new one
+    void endFrame();
+
+    std::uint64_t getFrameCount() const;
+
+    // Copy of recorded frames, oldest first
+    std::vector<FrameTimings> getFrames() const;
+
+    // Per phase statistics over recorded frames, whole frame last
+    std::array<PhaseStats, PhaseCount + 1> getStats() const;
+
+    // Human readable statistics, one line per phase
+    std::string report() const;
+};
+
+class ScopedZone {
+    Phase _phase;
+    bool _active;
+    Profiler::Clock::time_point _start;
+
+  public:
+    ScopedZone(Phase phase) : _phase(phase), _active(Profiler::Get().isEnabled()) {
+        if (_active)
+            _start = Profiler::Clock::now();
+    }
+
+    ~ScopedZone() {
+        if (_active)
+            Profiler::Get().record(_phase, Profiler::Clock::now() - _start);
+    }
+
+    ScopedZone(const ScopedZone &) = delete;
+    ScopedZone &operator=(const ScopedZone &) = delete;
+};
+
+} // namespace profiling
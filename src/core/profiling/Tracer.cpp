@@ -0,0 +1,140 @@
+#include "./Tracer.h"
+
+#include <format>
+#include <raylib.h>
+
+namespace profiling {
+
+Tracer::Tracer() : _active(false), _firstEvent(true), _stopRequested(false) {}
+
+Tracer::~Tracer() {
+    stop();
+}
+
+bool Tracer::start(const std::filesystem::path &path) {
+    if (isActive())
+        return false;
+
+    _output.open(path, std::ios::trunc);
+    if (!_output) {
+        TraceLog(LOG_ERROR, "[Tracer] Unable to open %s", path.string().c_str());
+        return false;
+    }
+
+    _output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    _firstEvent = true;
+    _origin = Clock::now();
+    _stopRequested = false;
+    _active.store(true, std::memory_order_release);
+    _flushThread = std::thread(&Tracer::flushLoop, this);
+
+    return true;
+}
+
+void Tracer::stop() {
+    if (!isActive())
+        return;
+
+    _active.store(false, std::memory_order_release);
+    {
+        std::lock_guard lock(_flushMutex);
+        _stopRequested = true;
+    }
+    _flushCondition.notify_one();
+    _flushThread.join();
+
+    flush();
+    _output << "]}\n";
+    _output.close();
+
+    if (const auto dropped = getDroppedCount())
+        TraceLog(LOG_WARNING, "[Tracer] %llu events dropped, buffers were full", (unsigned long long)dropped);
+}
+
+Tracer::ThreadBuffer &Tracer::getThreadBuffer() {
+    // buffer is shared with the tracer so pending events survive thread exit
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+        std::lock_guard lock(_buffersMutex);
+        buffer->threadId = _buffers.size() + 1;
+        _buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void Tracer::record(const char *name, const char *category, Clock::time_point start, Clock::time_point end) {
+    if (!isActive())
+        return;
+
+    auto &buffer = getThreadBuffer();
+    const auto head = buffer.head.load(std::memory_order_relaxed);
+    if (head - buffer.tail.load(std::memory_order_acquire) >= BufferCapacity) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[head % BufferCapacity] = TraceEvent{name, category, start, end - start};
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Tracer::instant(const char *name, const char *category) {
+    const auto now = Clock::now();
+    record(name, category, now, now - Clock::duration(1));
+}
+
+std::uint64_t Tracer::getDroppedCount() {
+    std::lock_guard lock(_buffersMutex);
+    std::uint64_t dropped = 0;
+    for (const auto &buffer : _buffers)
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    return dropped;
+}
+
+void Tracer::flushLoop() {
+    std::unique_lock lock(_flushMutex);
+    while (!_stopRequested) {
+        _flushCondition.wait_for(lock, FlushInterval, [this] { return _stopRequested; });
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+void Tracer::flush() {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard lock(_buffersMutex);
+        buffers = _buffers;
+    }
+
+    for (const auto &buffer : buffers) {
+        const auto head = buffer->head.load(std::memory_order_acquire);
+        auto tail = buffer->tail.load(std::memory_order_relaxed);
+
+        for (; tail != head; ++tail)
+            writeEvent(buffer->events[tail % BufferCapacity], buffer->threadId);
+
+        buffer->tail.store(tail, std::memory_order_release);
+    }
+
+    _output.flush();
+}
+
+void Tracer::writeEvent(const TraceEvent &event, std::uint32_t threadId) {
+    using Microseconds = std::chrono::duration<double, std::micro>;
+    const auto timestamp = Microseconds(event.start - _origin).count();
+
+    if (!_firstEvent)
+        _output << ',';
+    _firstEvent = false;
+
+    if (event.duration < Clock::duration::zero())
+        _output << std::format(R"({{"name":"{}","cat":"{}","ph":"i","s":"t","pid":1,"tid":{},"ts":{:.3f}}})",
+                               event.name, event.category, threadId, timestamp);
+    else
+        _output << std::format(R"({{"name":"{}","cat":"{}","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                               event.name, event.category, threadId, timestamp, Microseconds(event.duration).count());
+}
+
+} // namespace profiling
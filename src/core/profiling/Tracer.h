@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define PROFILING_CONCAT_IMPL(a, b) a##b
+#define PROFILING_CONCAT(a, b) PROFILING_CONCAT_IMPL(a, b)
+
+#ifdef UI_PROFILING
+#define TRACE_ZONE(name) ::profiling::TraceZone PROFILING_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_ZONE_CATEGORY(name, category) ::profiling::TraceZone PROFILING_CONCAT(traceZone, __LINE__)(name, category)
+#else
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_ZONE_CATEGORY(name, category) ((void)0)
+#endif
+
+namespace profiling {
+
+/**
+ * Writes Chrome Trace Event Format JSON (readable by chrome://tracing and Perfetto).
+ * Every thread records into its own single-producer ring buffer, a background thread
+ * drains the buffers and formats the events so recording only costs a few stores.
+ * Zone names and categories must outlive the tracer (string literals).
+ */
+class Tracer {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    struct TraceEvent {
+        const char *name;
+        const char *category;
+        Clock::time_point start;
+        Clock::duration duration; // negative for instant events
+    };
+
+    static constexpr std::size_t BufferCapacity = 1 << 14;
+    static constexpr auto FlushInterval = std::chrono::milliseconds(50);
+
+  private:
+    struct ThreadBuffer {
+        std::array<TraceEvent, BufferCapacity> events;
+        std::atomic<std::size_t> head{0}; // written by owning thread
+        std::atomic<std::size_t> tail{0}; // written by flush thread
+        std::atomic<std::uint64_t> dropped{0};
+        std::uint32_t threadId;
+    };
+
+    std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+    std::mutex _buffersMutex; // only locked on thread registration and flush
+
+    std::ofstream _output;
+    std::atomic<bool> _active;
+    bool _firstEvent;
+    Clock::time_point _origin;
+
+    std::thread _flushThread;
+    std::mutex _flushMutex;
+    std::condition_variable _flushCondition;
+    bool _stopRequested;
+
+    Tracer();
+    ~Tracer();
+
+    ThreadBuffer &getThreadBuffer();
+    void flushLoop();
+    void flush();
+    void writeEvent(const TraceEvent &event, std::uint32_t threadId);
+
+  public:
+    static Tracer &Get() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    // Opens output file and starts the flush thread
+    bool start(const std::filesystem::path &path);
+
+    // Flushes pending events and closes the JSON document
+    void stop();
+
+    bool isActive() const {
+        return _active.load(std::memory_order_relaxed);
+    }
+
+    void record(const char *name, const char *category, Clock::time_point start, Clock::time_point end);
+    void instant(const char *name, const char *category);
+
+    // Events lost because a thread buffer was full
+    std::uint64_t getDroppedCount();
+};
+
+class TraceZone {
+    const char *_name;
+    const char *_category;
+    bool _active;
+    Tracer::Clock::time_point _start;
+
+  public:
+    TraceZone(const char *name, const char *category = "ui")
+        : _name(name), _category(category), _active(Tracer::Get().isActive()) {
+        if (_active)
+            _start = Tracer::Clock::now();
+    }
+
+    ~TraceZone() {
+        if (_active)
+            Tracer::Get().record(_name, _category, _start, Tracer::Clock::now());
+    }
+
+    TraceZone(const TraceZone &) = delete;
+    TraceZone &operator=(const TraceZone &) = delete;
+};
+
+} // namespace profiling
@@ -1,12 +1,14 @@
 #pragma once
 
+#include <filesystem>
 #include <vector>
+#include "./bundle/AssetBundle.h"
 #include "./repository/FontRepository.h"
 #include "./repository/TextureRepository.h"
 
 namespace repository {
 
-std::vector<Repository*> InitRepositories() {
+inline std::vector<Repository*> InitRepositories() {
   std::vector<Repository*> repositories;
   repositories.emplace_back(FontRepository::Get());
   repositories.emplace_back(TextureRepository::Get());
@@ -14,4 +16,15 @@ std::vector<Repository*> InitRepositories() {
   return repositories;
 }
 
+// Fonts and textures packed in bundle at `path` are then loaded from it
+inline bool MountBundle(const std::filesystem::path& path) {
+  auto mapped = bundle::AssetBundle::Open(path);
+  if (!mapped)
+    return false;
+
+  FontRepository::Get()->mount(mapped);
+  TextureRepository::Get()->mount(mapped);
+  return true;
+}
+
 }  // namespace repository
\ No newline at end of file
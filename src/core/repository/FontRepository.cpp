@@ -1,41 +1,116 @@
 #include "./FontRepository.h"
+#include "../../ui/rendering/backend/DrawBackend.h"
+#include "../bundle/AssetBundle.h"
+#include "../profiling/Tracer.h"
 
 namespace fs = std::filesystem;
 
-repository::FontRepository *repository::FontRepository::instance = nullptr;
+std::atomic<repository::FontRepository *> repository::FontRepository::instance = nullptr;
+std::mutex repository::FontRepository::instanceMutex;
 
 namespace repository {
 
+namespace {
+
+// Glyphs keep no image, atlas is enough to draw them
+std::optional<Font> uploadFont(const bundle::FontView &view) {
+    Font font{};
+    font.baseSize = view.baseSize;
+    font.glyphCount = view.glyphCount;
+    font.glyphPadding = view.glyphPadding;
+    font.glyphs = static_cast<GlyphInfo *>(MemAlloc(view.glyphCount * sizeof(GlyphInfo)));
+    font.recs = static_cast<Rectangle *>(MemAlloc(view.glyphCount * sizeof(Rectangle)));
+    for (int i = 0; i < view.glyphCount; ++i) {
+        const auto &glyph = view.glyphs[i];
+        font.glyphs[i] = GlyphInfo{.value = glyph.value, .offsetX = glyph.offsetX, .offsetY = glyph.offsetY, .advanceX = glyph.advanceX, .image = {}};
+        font.recs[i] = Rectangle{glyph.x, glyph.y, glyph.width, glyph.height};
+    }
+
+    auto &backend = ui::rendering::backend::DrawBackend::Get();
+    font.texture = backend.loadTexture(view.atlas);
+    if (font.texture.id == 0) {
+        backend.unloadFont(font);
+        return std::nullopt;
+    }
+    return font;
+}
+
+std::shared_ptr<const Font> share(const Font &font) {
+    return std::shared_ptr<const Font>(new Font(font), [](const Font *font) {
+        ui::rendering::backend::DrawBackend::Get().unloadFont(*font);
+        delete font;
+    });
+}
+
+} // namespace
+
 FontRepository::FontRepository() {
     instance = this;
 }
 
 FontRepository::~FontRepository() {
-    for (auto &[handle, font] : _fonts) {
-        UnloadFont(font);
-    }
+    _fonts.drain(); // unloads fonts nobody else holds
+    instance = nullptr;
 }
 
 FontRepository *FontRepository::Get() {
-    if (!instance)
-        instance = new FontRepository;
+    if (auto repository = instance.load(std::memory_order_acquire))
+        return repository;
+
+    std::lock_guard lock(instanceMutex);
+    if (!instance.load(std::memory_order_relaxed))
+        new FontRepository; // registers itself
+    return instance.load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<const Font> FontRepository::get(const std::string &handle) const {
+    return _fonts.get(_fonts.find(handle)).value_or(nullptr);
+}
+
+FontHandle FontRepository::resolve(const std::string &handle) {
+    return _fonts.intern(handle);
+}
+
+FontHandle FontRepository::resolve(const std::vector<std::string> &fontFamily) {
+    for (const auto &fontName : fontFamily) {
+        auto handle = _fonts.intern(fontName);
+        if (_fonts.get(handle))
+            return handle;
+    }
+    return {};
+}
+
+std::shared_ptr<const Font> FontRepository::get(FontHandle handle) const {
+    return _fonts.get(handle).value_or(nullptr);
+}
+
+bool FontRepository::isStale(FontHandle handle) const {
+    return _fonts.isStale(handle);
+}
+
+FontHandle FontRepository::refresh(FontHandle handle) const {
+    return _fonts.refresh(handle);
+}
 
-    return instance;
+std::uint64_t FontRepository::getVersion() const {
+    return _fonts.getVersion();
 }
 
-std::optional<Font> FontRepository::get(const std::string &handle) {
-    if (_fonts.count(handle) > 0)
-        return std::make_optional<Font>(_fonts[handle]);
-    return std::nullopt;
+bool FontRepository::unload(const std::string &handle) {
+    // unloaded once last holder drops it
+    return _fonts.erase(handle).has_value();
 }
 
 bool FontRepository::load(const std::string &handle, const fs::path &resource) {
-    if (!fs::exists(resource) || !fs::is_regular_file(resource))
-        return false;
+    TRACE_ZONE_CATEGORY("FontRepository::load", "asset");
+    std::optional<Font> font;
+    if (auto view = findBundled([name = resource.generic_string()](const bundle::AssetBundle &bundle) { return bundle.findFont(name); }))
+        font = uploadFont(*view);
+    else if (fs::exists(resource) && fs::is_regular_file(resource))
+        font = ui::rendering::backend::DrawBackend::Get().loadFont(resource);
 
-    auto font = LoadFont(resource.string().c_str());
-    if (font.texture.id != 0 && font.glyphCount > 0) {
-        _fonts[handle] = font;
+    if (font && font->glyphCount > 0) {
+        _fonts.assign(handle, share(*font)); // replaced one is unloaded once last holder drops it
         return true;
     }
 
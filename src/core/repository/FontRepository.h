@@ -1,27 +1,61 @@
 #pragma once
 
 #include <raylib.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
-#include <unordered_map>
+#include <vector>
 #include "./Repository.h"
+#include "./SlotTable.h"
 
 namespace repository {
 
+// Fonts are shared : glyphs and atlas are only unloaded once the last holder
+// drops it, so replacing or unloading one never frees what a reader still uses
 class FontRepository : public Repository {
-  static FontRepository* instance;
-  std::unordered_map<std::string, Font> _fonts;
+  static std::atomic<FontRepository*> instance;
+  static std::mutex instanceMutex;
+  SlotTable<std::shared_ptr<const Font>, FontTag> _fonts;
 
   FontRepository();
   ~FontRepository();
 
  public:
+  // Creates repository on first call, safe from any thread
   static FontRepository* Get();
 
+  // Decodes and uploads outside any lock, replaces (and unloads) asset
+  // previously registered under `handle`
   bool load(const std::string& handle,
             const std::filesystem::path& resource) override;
 
-  std::optional<Font> get(const std::string& handle);
+  // Unloads asset registered under `handle`, its FontHandles become stale
+  bool unload(const std::string& handle);
 
+  // Safe from any thread, concurrent lookups do not block each other.
+  // `nullptr` if not loaded
+  std::shared_ptr<const Font> get(const std::string& handle) const;
+
+  // Resolves `handle` once, for lookups without hashing. Resolved before
+  // loading, it becomes usable once the asset is first loaded
+  FontHandle resolve(const std::string& handle);
+
+  // First loaded font of `fontFamily`, invalid handle if none is
+  FontHandle resolve(const std::vector<std::string>& fontFamily);
+
+  // `nullptr` if `handle` is stale
+  std::shared_ptr<const Font> get(FontHandle handle) const;
+
+  // Asset was replaced or unloaded since `handle` was resolved
+  bool isStale(FontHandle handle) const;
+
+  // Same asset name, current generation
+  FontHandle refresh(FontHandle handle) const;
+
+  // Bumped on every load and unload
+  std::uint64_t getVersion() const;
 };
 
 }  // namespace repository
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace repository {
+
+/**
+ * Index of an asset slot in its repository, along with the slot generation it was resolved at.
+ * Replacing or unloading the asset bumps the generation : stale handles resolve to nothing.
+ */
+template <typename Tag>
+struct Handle {
+    static constexpr std::uint32_t InvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t index = InvalidIndex;
+    std::uint32_t generation = 0;
+
+    bool isValid() const {
+        return index != InvalidIndex;
+    }
+
+    bool operator==(const Handle &) const = default;
+};
+
+using TextureHandle = Handle<struct TextureTag>;
+using FontHandle = Handle<struct FontTag>;
+
+} // namespace repository
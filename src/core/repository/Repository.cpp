@@ -1,8 +1,14 @@
 #include "./Repository.h"
+#include "../bundle/AssetBundle.h"
 
 namespace repository {
+void Repository::mount(std::shared_ptr<const bundle::AssetBundle> bundle) {
+  std::lock_guard lock(_bundlesMutex);
+  _bundles.insert(_bundles.begin(), std::move(bundle));
+}
+
 void Repository::Clear(const std::vector<Repository*>& repositories) {
   for (auto repository : repositories)
     delete repository;
 }
-}  // namespace repository
\ No newline at end of file
+}  // namespace repository
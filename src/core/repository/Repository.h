@@ -1,20 +1,46 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
+namespace bundle {
+class AssetBundle;
+}
+
 namespace repository {
 
 class Repository {
+    std::vector<std::shared_ptr<const bundle::AssetBundle>> _bundles; // latest mounted first
+    mutable std::shared_mutex _bundlesMutex;
+
 protected:
     virtual ~Repository() = default;
+
+    // First asset `find(bundle)` returns, from latest mounted bundle to oldest
+    template <typename F>
+    auto findBundled(F&& find) const -> decltype(find(std::declval<const bundle::AssetBundle&>())) {
+        std::shared_lock lock(_bundlesMutex);
+        for (const auto& bundle : _bundles)
+            if (auto asset = find(*bundle))
+                return asset;
+        return std::nullopt;
+    }
+
 public:
     virtual bool load(const std::string& handle,
                       const std::filesystem::path& resource) = 0;
 
+    // Resources packed in `bundle` are then loaded from it instead of the file system,
+    // `bundle` stays mapped as long as the repository lives
+    void mount(std::shared_ptr<const bundle::AssetBundle> bundle);
+
     static void Clear(const std::vector<Repository*>& repositories);
 };
 
-}  // namespace repository
\ No newline at end of file
+}  // namespace repository
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "../ShardedMap.h"
+#include "./Handle.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace repository {
+
+/**
+ * Assets stored in slots, one per interned name and never reused, so handles are plain indices.
+ * Names are only hashed when resolving a handle, dereferencing one is a bounds and generation check.
+ * Slots count their holders and remember whether they were read since last `sweep`, for eviction.
+ */
+template <typename T, typename Tag>
+class SlotTable {
+    struct Slot {
+        std::string name;
+        std::optional<T> asset;
+        std::uint32_t generation = 0;
+        std::uint32_t references = 0;
+        mutable std::atomic<bool> used = false; // CLOCK reference bit
+    };
+
+    ShardedMap<std::string, std::uint32_t> _indices;
+    std::deque<Slot> _slots; // stable on growth
+    mutable std::shared_mutex _mutex;
+    std::atomic<std::uint64_t> _version = 0;
+    std::size_t _hand = 0; // CLOCK position
+
+    Handle<Tag> handleOf(std::uint32_t index) const {
+        return {index, _slots[index].generation};
+    }
+
+  public:
+    // Invalid handle if `name` was never interned
+    Handle<Tag> find(const std::string &name) const {
+        auto index = _indices.find(name);
+        if (!index)
+            return {};
+
+        std::shared_lock lock(_mutex);
+        return handleOf(*index);
+    }
+
+    // Creates an empty slot for `name` if needed, the handle stays valid once an asset is first stored in it
+    Handle<Tag> intern(const std::string &name) {
+        if (auto handle = find(name); handle.isValid())
+            return handle;
+
+        std::lock_guard lock(_mutex);
+        if (auto index = _indices.find(name)) // interned meanwhile
+            return handleOf(*index);
+
+        const auto index = static_cast<std::uint32_t>(_slots.size());
+        _slots.emplace_back().name = name;
+        _indices.assign(name, index);
+        return handleOf(index);
+    }
+
+    std::optional<T> get(Handle<Tag> handle) const {
+        std::shared_lock lock(_mutex);
+        if (handle.index >= _slots.size())
+            return std::nullopt;
+
+        const auto &slot = _slots[handle.index];
+        if (slot.generation != handle.generation)
+            return std::nullopt;
+        slot.used.store(true, std::memory_order_relaxed);
+        return slot.asset;
+    }
+
+    // Name `handle` was resolved from, empty for invalid handles
+    std::string nameOf(Handle<Tag> handle) const {
+        std::shared_lock lock(_mutex);
+        if (handle.index >= _slots.size())
+            return {};
+        return _slots[handle.index].name;
+    }
+
+    // Holders of a slot, whatever its generation. Unheld slots are evicted first
+    void retain(Handle<Tag> handle) {
+        std::lock_guard lock(_mutex);
+        if (handle.index < _slots.size())
+            _slots[handle.index].references++;
+    }
+
+    void release(Handle<Tag> handle) {
+        std::lock_guard lock(_mutex);
+        if (handle.index < _slots.size() && _slots[handle.index].references > 0)
+            _slots[handle.index].references--;
+    }
+
+    // Asset was replaced or unloaded since `handle` was resolved
+    bool isStale(Handle<Tag> handle) const {
+        std::shared_lock lock(_mutex);
+        return handle.index < _slots.size() && _slots[handle.index].generation != handle.generation;
+    }
+
+    // Same slot, current generation
+    Handle<Tag> refresh(Handle<Tag> handle) const {
+        std::shared_lock lock(_mutex);
+        if (handle.index >= _slots.size())
+            return {};
+        return handleOf(handle.index);
+    }
+
+    // Stores `asset` under `name`, returns replaced asset if any
+    std::optional<T> assign(const std::string &name, T asset) {
+        const auto index = intern(name).index;
+
+        std::lock_guard lock(_mutex);
+        auto &slot = _slots[index];
+        auto replaced = std::exchange(slot.asset, std::move(asset));
+        if (replaced)
+            slot.generation++;
+        slot.used.store(true, std::memory_order_relaxed); // not evicted before first read
+        _version++;
+        return replaced;
+    }
+
+    // Returns unloaded asset if any, `name` stays interned
+    std::optional<T> erase(const std::string &name) {
+        auto index = _indices.find(name);
+        if (!index)
+            return std::nullopt;
+
+        std::lock_guard lock(_mutex);
+        auto &slot = _slots[*index];
+        auto erased = std::exchange(slot.asset, std::nullopt);
+        if (erased) {
+            slot.generation++;
+            _version++;
+        }
+        return erased;
+    }
+
+    // Returns every asset, leaving slots empty
+    std::vector<T> drain() {
+        std::vector<T> assets;
+        std::lock_guard lock(_mutex);
+        for (auto &slot : _slots) {
+            if (auto asset = std::exchange(slot.asset, std::nullopt)) {
+                assets.push_back(std::move(*asset));
+                slot.generation++;
+            }
+        }
+        _version++;
+        return assets;
+    }
+
+    /**
+     * One CLOCK revolution at most, from where last one stopped : slots read since last sweep
+     * get a second chance, others are emptied until `evict(asset)` returns false.
+     * Held slots are skipped, their reference bit untouched, unless `evictHeld`.
+     * `evict` is called with the table locked and must not use it.
+     */
+    template <typename F>
+    void sweep(F &&evict, bool evictHeld) {
+        std::lock_guard lock(_mutex);
+        for (std::size_t visited = 0; visited < _slots.size(); ++visited) {
+            auto &slot = _slots[_hand];
+            _hand = (_hand + 1) % _slots.size();
+
+            if (!slot.asset || (slot.references > 0 && !evictHeld))
+                continue;
+            if (slot.used.exchange(false, std::memory_order_relaxed))
+                continue;
+
+            auto asset = std::exchange(slot.asset, std::nullopt);
+            slot.generation++;
+            _version++;
+            if (!evict(std::move(*asset)))
+                return;
+        }
+    }
+
+    // Bumped whenever an asset is stored or unloaded, to tell when a name lookup might resolve differently
+    std::uint64_t getVersion() const {
+        return _version.load(std::memory_order_acquire);
+    }
+};
+
+} // namespace repository
@@ -1,41 +1,224 @@
 #include "./TextureRepository.h"
+#include "../../ui/rendering/backend/DrawBackend.h"
+#include "../async/Awaitables.h"
+#include "../bundle/AssetBundle.h"
+#include "../profiling/Tracer.h"
 
 namespace fs = std::filesystem;
 
-repository::TextureRepository *repository::TextureRepository::instance = nullptr;
+std::atomic<repository::TextureRepository *> repository::TextureRepository::instance = nullptr;
+std::mutex repository::TextureRepository::instanceMutex;
 
 namespace repository {
 
+namespace {
+
+std::uint64_t bytesOf(const Texture2D &texture) {
+    return GetPixelDataSize(texture.width, texture.height, texture.format);
+}
+
+} // namespace
+
 TextureRepository::TextureRepository() {
     instance = this;
 }
 
 TextureRepository::~TextureRepository() {
-    for (auto &[handle, texture] : _textures) {
-        UnloadTexture(texture);
-    }
+    for (auto &texture : _textures.drain())
+        ui::rendering::backend::DrawBackend::Get().unloadTexture(texture);
     instance = nullptr;
 }
 
 TextureRepository *TextureRepository::Get() {
-    if (!instance)
-        instance = new TextureRepository;
+    if (auto repository = instance.load(std::memory_order_acquire))
+        return repository;
+
+    std::lock_guard lock(instanceMutex);
+    if (!instance.load(std::memory_order_relaxed))
+        new TextureRepository; // registers itself
+    return instance.load(std::memory_order_relaxed);
+}
+
+bool TextureRepository::Exists() {
+    return instance.load(std::memory_order_acquire) != nullptr;
+}
+
+std::optional<Texture2D> TextureRepository::get(const std::string &handle) const {
+    return _textures.get(_textures.find(handle));
+}
+
+TextureHandle TextureRepository::resolve(const std::string &handle) {
+    return _textures.intern(handle);
+}
+
+std::optional<Texture2D> TextureRepository::get(TextureHandle handle) const {
+    return _textures.get(handle);
+}
+
+bool TextureRepository::isStale(TextureHandle handle) const {
+    return _textures.isStale(handle);
+}
+
+TextureHandle TextureRepository::refresh(TextureHandle handle) const {
+    return _textures.refresh(handle);
+}
+
+std::uint64_t TextureRepository::getVersion() const {
+    return _textures.getVersion();
+}
+
+bool TextureRepository::unload(const std::string &handle) {
+    auto texture = _textures.erase(handle);
+    if (!texture)
+        return false;
+
+    _residentBytes -= bytesOf(*texture);
+    ui::rendering::backend::DrawBackend::Get().unloadTexture(*texture);
+    return true;
+}
 
-    return instance;
+void TextureRepository::store(const std::string &handle, const fs::path &resource, const Texture2D &texture) {
+    _resources.assign(handle, resource);
+    _residentBytes += bytesOf(texture);
+    if (auto replaced = _textures.assign(handle, texture)) {
+        _residentBytes -= bytesOf(*replaced);
+        ui::rendering::backend::DrawBackend::Get().unloadTexture(*replaced);
+    }
 }
 
-std::optional<Texture2D> TextureRepository::get(const std::string &handle) {
-    if (_textures.count(handle) > 0)
-        return std::make_optional<Texture>(_textures[handle]);
-    return std::nullopt;
+std::optional<Texture2D> TextureRepository::loadBundled(const fs::path &resource) {
+    auto image = findBundled([name = resource.generic_string()](const bundle::AssetBundle &bundle) {
+        return bundle.findTexture(name);
+    });
+    if (!image)
+        return std::nullopt;
+
+    // straight from mapped pages, image is not owned
+    auto texture = ui::rendering::backend::DrawBackend::Get().loadTexture(*image);
+    if (texture.id == 0)
+        return std::nullopt;
+    return texture;
 }
 
 bool TextureRepository::load(const std::string &handle, const fs::path &resource) {
+    TRACE_ZONE_CATEGORY("TextureRepository::load", "asset");
+    if (auto texture = loadBundled(resource)) {
+        store(handle, resource, *texture);
+        return true;
+    }
+
     if (!fs::exists(resource) || !fs::is_regular_file(resource))
         return false;
-    auto texture = LoadTexture(resource.string().c_str());
-    _textures[handle] = texture;
+
+    // decoded on CPU, only upload depends on draw backend
+    auto image = LoadImage(resource.string().c_str());
+    if (!image.data)
+        return false;
+
+    auto texture = ui::rendering::backend::DrawBackend::Get().loadTexture(image);
+    UnloadImage(image);
+    if (texture.id == 0)
+        return false;
+
+    store(handle, resource, texture);
     return true;
 }
 
+async::Task<bool> TextureRepository::loadAsync(std::string handle, fs::path resource) {
+    if (auto texture = loadBundled(resource)) { // nothing to decode
+        store(handle, resource, *texture);
+        async::Executor::Get().requestFrame();
+        co_return true;
+    }
+
+    auto image = co_await async::Worker([resource] {
+        TRACE_ZONE_CATEGORY("TextureRepository::decode", "asset");
+        if (!fs::exists(resource) || !fs::is_regular_file(resource))
+            return ::Image{};
+        return LoadImage(resource.string().c_str());
+    });
+    if (!image.data)
+        co_return false;
+
+    auto texture = ui::rendering::backend::DrawBackend::Get().loadTexture(image);
+    UnloadImage(image);
+    if (texture.id == 0)
+        co_return false;
+
+    store(handle, resource, texture);
+    async::Executor::Get().requestFrame(); // elements showing it are not invalidated
+    co_return true;
+}
+
+async::Task<void> TextureRepository::reload(TextureHandle handle, std::string name, fs::path resource) {
+    if (co_await loadAsync(name, resource))
+        _reloads++;
+    else
+        TraceLog(LOG_WARNING, "[TextureRepository] Failed to reload %s from %s", name.c_str(), resource.string().c_str());
+
+    std::lock_guard lock(_reloadingMutex);
+    _reloading.erase(handle.index);
+}
+
+void TextureRepository::retain(TextureHandle handle) {
+    _textures.retain(handle);
+}
+
+void TextureRepository::release(TextureHandle handle) {
+    _textures.release(handle);
+}
+
+void TextureRepository::request(TextureHandle handle) {
+    if (!handle.isValid() || _textures.get(_textures.refresh(handle)))
+        return;
+
+    const auto name = _textures.nameOf(handle);
+    const auto resource = _resources.find(name);
+    if (!resource) // never loaded from a file
+        return;
+
+    if (!async::Executor::Exists()) {
+        if (load(name, *resource))
+            _reloads++;
+        return;
+    }
+
+    {
+        std::lock_guard lock(_reloadingMutex);
+        if (!_reloading.insert(handle.index).second)
+            return;
+    }
+    async::Spawn(reload(handle, name, *resource));
+}
+
+void TextureRepository::setMemoryBudget(std::uint64_t budget) {
+    _budget = budget;
+}
+
+void TextureRepository::enforceBudget() {
+    const auto budget = _budget.load();
+    if (budget == 0 || _residentBytes <= budget)
+        return;
+
+    TRACE_ZONE_CATEGORY("TextureRepository::enforceBudget", "asset");
+    auto evict = [this, budget](Texture2D texture) {
+        _residentBytes -= bytesOf(texture);
+        _evictions++;
+        ui::rendering::backend::DrawBackend::Get().unloadTexture(texture);
+        return _residentBytes > budget;
+    };
+
+    _textures.sweep(evict, false);
+    if (_residentBytes > budget)
+        _textures.sweep(evict, true);
+}
+
+TextureRepository::Stats TextureRepository::getStats() const {
+    return Stats{
+        .residentBytes = _residentBytes,
+        .budget = _budget,
+        .evictions = _evictions,
+        .reloads = _reloads};
+}
+
 } // namespace repository
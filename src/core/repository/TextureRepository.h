@@ -1,27 +1,113 @@
 #pragma once
 
 #include <raylib.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <optional>
-#include <unordered_map>
+#include <unordered_set>
+#include "../ShardedMap.h"
+#include "../async/Task.h"
 #include "./Repository.h"
+#include "./SlotTable.h"
 
 namespace repository {
 
+/**
+ * Textures loaded from files stay reloadable : under a memory budget, textures not drawn
+ * since last `enforceBudget` get evicted (CLOCK), those no Image holds first.
+ * Evicted ones are reloaded in the background once `request`ed again.
+ */
 class TextureRepository : public Repository {
-  static TextureRepository* instance;
-  std::unordered_map<std::string, Texture2D> _textures;
+ public:
+  struct Stats {
+    std::uint64_t residentBytes;
+    std::uint64_t budget;  // in bytes, 0 when unlimited
+    std::uint64_t evictions;
+    std::uint64_t reloads;
+  };
+
+ private:
+  static std::atomic<TextureRepository*> instance;
+  static std::mutex instanceMutex;
+  SlotTable<Texture2D, TextureTag> _textures;
+  ShardedMap<std::string, std::filesystem::path> _resources;  // for reloads
+
+  std::mutex _reloadingMutex;
+  std::unordered_set<std::uint32_t> _reloading;  // slot indices
+
+  std::atomic<std::uint64_t> _residentBytes = 0;
+  std::atomic<std::uint64_t> _budget = 0;
+  std::atomic<std::uint64_t> _evictions = 0;
+  std::atomic<std::uint64_t> _reloads = 0;
 
   TextureRepository();
   ~TextureRepository();
 
+  // Registers uploaded `texture`, unloading the one it replaces
+  void store(const std::string& handle, const std::filesystem::path& resource,
+             const Texture2D& texture);
+
+  // Uploads texture packed as `resource` in a mounted bundle, no decoding
+  std::optional<Texture2D> loadBundled(const std::filesystem::path& resource);
+
+  async::Task<void> reload(TextureHandle handle, std::string name,
+                           std::filesystem::path resource);
+
  public:
+  // Creates repository on first call, safe from any thread
   static TextureRepository* Get();
 
+  // Whether `Get` would not create one
+  static bool Exists();
+
+  // Decodes and uploads outside any lock, replaces (and unloads) asset
+  // previously registered under `handle`
   bool load(const std::string& handle,
             const std::filesystem::path& resource) override;
 
-  std::optional<Texture2D> get(const std::string& handle);
-  
+  // Same as `load`, decoding on a worker thread : resumes on the UI thread
+  // once the texture is uploaded and requests a frame
+  async::Task<bool> loadAsync(std::string handle, std::filesystem::path resource);
+
+  // Unloads asset registered under `handle`, its TextureHandles become stale
+  bool unload(const std::string& handle);
+
+  // Safe from any thread, concurrent lookups do not block each other
+  std::optional<Texture2D> get(const std::string& handle) const;
+
+  // Resolves `handle` once, for lookups without hashing. Resolved before
+  // loading, it becomes usable once the asset is first loaded
+  TextureHandle resolve(const std::string& handle);
+
+  // Nothing if `handle` is stale
+  std::optional<Texture2D> get(TextureHandle handle) const;
+
+  // Asset was replaced or unloaded since `handle` was resolved
+  bool isStale(TextureHandle handle) const;
+
+  // Same asset name, current generation
+  TextureHandle refresh(TextureHandle handle) const;
+
+  // Bumped on every load and unload
+  std::uint64_t getVersion() const;
+
+  // Held textures are only evicted once every unheld one is
+  void retain(TextureHandle handle);
+  void release(TextureHandle handle);
+
+  // Reloads texture of `handle` in the background if it was evicted,
+  // without executor it is reloaded right away
+  void request(TextureHandle handle);
+
+  // In bytes, 0 for no limit. Only enforced by `enforceBudget`
+  void setMemoryBudget(std::uint64_t budget);
+
+  // Evicts textures until resident ones fit the memory budget, to be called
+  // right after painting so that drawn textures are the last ones evicted
+  void enforceBudget();
+
+  Stats getStats() const;
 };
 
 }  // namespace repository
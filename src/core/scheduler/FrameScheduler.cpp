@@ -0,0 +1,255 @@
+#include "./FrameScheduler.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace scheduler {
+
+IdleDeadline::IdleDeadline(Clock::time_point deadline, bool didTimeout)
+    : _deadline(deadline), _didTimeout(didTimeout) {}
+
+double IdleDeadline::timeRemaining() const {
+    return std::max(0.0, Milliseconds(_deadline - Clock::now()).count());
+}
+
+bool IdleDeadline::didTimeout() const {
+    return _didTimeout;
+}
+
+FrameScheduler::FrameScheduler(Milliseconds budget)
+    : _nextId(1), _budget(budget), _origin(Clock::now()), _frameStart(_origin) {}
+
+void FrameScheduler::setBudget(Milliseconds budget) {
+    _budget = budget;
+}
+
+Milliseconds FrameScheduler::getBudget() const {
+    return _budget;
+}
+
+void FrameScheduler::setWakeUp(std::function<void()> wakeUp) {
+    _wakeUp = std::move(wakeUp);
+}
+
+void FrameScheduler::beginFrame() {
+    _frameStart = Clock::now();
+}
+
+Clock::time_point FrameScheduler::getFrameStart() const {
+    return _frameStart;
+}
+
+Milliseconds FrameScheduler::getElapsed() const {
+    return Clock::now() - _frameStart;
+}
+
+Milliseconds FrameScheduler::getRemainingBudget() const {
+    return std::max(Milliseconds(0), _budget - getElapsed());
+}
+
+void FrameScheduler::post(Priority priority, Task task) {
+    if (priority == Priority::Idle) {
+        requestIdleCallback([task = std::move(task)](const IdleDeadline &) { task(); });
+        return;
+    }
+
+    {
+        std::lock_guard lock(_mutex);
+        _tasks[static_cast<std::size_t>(priority)].push_back(std::move(task));
+    }
+    if (_wakeUp)
+        _wakeUp();
+}
+
+FrameScheduler::CallbackId FrameScheduler::requestAnimationFrame(AnimationCallback callback) {
+    CallbackId id;
+    {
+        std::lock_guard lock(_mutex);
+        id = _nextId++;
+        _animationCallbacks.emplace_back(id, std::move(callback));
+    }
+    if (_wakeUp)
+        _wakeUp();
+    return id;
+}
+
+void FrameScheduler::cancelAnimationFrame(CallbackId id) {
+    std::lock_guard lock(_mutex);
+    auto byId = [id](const auto &entry) { return entry.first == id; };
+    std::erase_if(_animationCallbacks, byId);
+
+    // may be cancelled by a callback of the same frame
+    auto it = std::find_if(_runningAnimationCallbacks.begin(), _runningAnimationCallbacks.end(), byId);
+    if (it != _runningAnimationCallbacks.end())
+        it->second = nullptr;
+}
+
+FrameScheduler::CallbackId FrameScheduler::requestIdleCallback(IdleCallback callback, std::optional<Milliseconds> timeout) {
+    std::optional<Clock::time_point> expiry;
+    if (timeout)
+        expiry = Clock::now() + std::chrono::duration_cast<Clock::duration>(*timeout);
+
+    CallbackId id;
+    {
+        std::lock_guard lock(_mutex);
+        id = _nextId++;
+        _idleCallbacks.push_back(IdleEntry{id, std::move(callback), expiry});
+    }
+    if (_wakeUp)
+        _wakeUp();
+    return id;
+}
+
+void FrameScheduler::cancelIdleCallback(CallbackId id) {
+    std::lock_guard lock(_mutex);
+    std::erase_if(_idleCallbacks, [id](const IdleEntry &entry) { return entry.id == id; });
+}
+
+FrameScheduler::CallbackId FrameScheduler::setTimeout(Task task, Milliseconds delay) {
+    const auto due = Clock::now() + std::chrono::duration_cast<Clock::duration>(delay);
+    CallbackId id;
+    {
+        std::lock_guard lock(_mutex);
+        id = _nextId++;
+        _timers.push_back(Timer{id, due, std::move(task)});
+    }
+    if (_wakeUp)
+        _wakeUp();
+    return id;
+}
+
+void FrameScheduler::clearTimeout(CallbackId id) {
+    std::lock_guard lock(_mutex);
+    std::erase_if(_timers, [id](const Timer &timer) { return timer.id == id; });
+}
+
+bool FrameScheduler::hasPendingWork() const {
+    const auto now = Clock::now();
+    std::lock_guard lock(_mutex);
+    return !_animationCallbacks.empty() || !_idleCallbacks.empty() ||
+           std::any_of(_timers.begin(), _timers.end(), [now](const Timer &timer) { return timer.due <= now; }) ||
+           std::any_of(_tasks.begin(), _tasks.end(), [](const auto &tasks) { return !tasks.empty(); });
+}
+
+std::optional<Clock::time_point> FrameScheduler::getNextTimerDue() const {
+    std::lock_guard lock(_mutex);
+    auto earliest = std::min_element(_timers.begin(), _timers.end(), [](const Timer &a, const Timer &b) { return a.due < b.due; });
+    if (earliest == _timers.end())
+        return std::nullopt;
+    return earliest->due;
+}
+
+void FrameScheduler::runTasks(Priority priority) {
+    if (priority == Priority::Idle)
+        return runIdle();
+
+    std::deque<Task> tasks;
+    auto &queue = _tasks[static_cast<std::size_t>(priority)];
+    {
+        std::lock_guard lock(_mutex);
+        tasks.swap(queue);
+    }
+
+    const bool budgeted = priority == Priority::Render;
+    while (!tasks.empty()) {
+        tasks.front()();
+        tasks.pop_front();
+
+        if (budgeted && getRemainingBudget() <= Milliseconds(0))
+            break;
+    }
+
+    // deferred tasks keep their turn before those posted meanwhile
+    if (!tasks.empty()) {
+        std::lock_guard lock(_mutex);
+        queue.insert(queue.begin(), std::make_move_iterator(tasks.begin()), std::make_move_iterator(tasks.end()));
+    }
+}
+
+void FrameScheduler::runTimers() {
+    std::vector<Timer> due;
+    {
+        std::lock_guard lock(_mutex);
+        const auto now = Clock::now();
+        auto isDue = [now](const Timer &timer) { return timer.due <= now; };
+        std::copy_if(std::make_move_iterator(_timers.begin()), std::make_move_iterator(_timers.end()),
+                     std::back_inserter(due), isDue);
+        std::erase_if(_timers, isDue);
+    }
+
+    std::sort(due.begin(), due.end(), [](const Timer &a, const Timer &b) {
+        return a.due != b.due ? a.due < b.due : a.id < b.id;
+    });
+    for (auto &timer : due)
+        timer.task();
+}
+
+void FrameScheduler::runAnimationFrames() {
+    {
+        std::lock_guard lock(_mutex);
+        _runningAnimationCallbacks.swap(_animationCallbacks);
+    }
+
+    const auto timestamp = Milliseconds(_frameStart - _origin).count();
+    for (std::size_t i = 0;; ++i) {
+        AnimationCallback callback;
+        {
+            std::lock_guard lock(_mutex);
+            if (i >= _runningAnimationCallbacks.size()) {
+                _runningAnimationCallbacks.clear();
+                break;
+            }
+            callback = std::move(_runningAnimationCallbacks[i].second);
+        }
+
+        if (callback)
+            callback(timestamp);
+    }
+
+    runTasks(Priority::Animation);
+}
+
+void FrameScheduler::runIdle() {
+    const auto deadline = _frameStart + std::chrono::duration_cast<Clock::duration>(_budget);
+    CallbackId last;
+    {
+        std::lock_guard lock(_mutex);
+        last = _nextId; // callbacks requested from now on wait for next frame
+    }
+
+    while (Clock::now() < deadline) {
+        IdleEntry entry;
+        {
+            std::lock_guard lock(_mutex);
+            if (_idleCallbacks.empty() || _idleCallbacks.front().id >= last)
+                break;
+            entry = std::move(_idleCallbacks.front());
+            _idleCallbacks.pop_front();
+        }
+
+        const bool didTimeout = entry.timeout && *entry.timeout <= Clock::now();
+        entry.callback(IdleDeadline(deadline, didTimeout));
+    }
+
+    // budget spent : only callbacks whose timeout expired
+    std::vector<IdleEntry> expired;
+    {
+        std::lock_guard lock(_mutex);
+        const auto now = Clock::now();
+        auto isExpired = [now, last](const IdleEntry &entry) {
+            return entry.id < last && entry.timeout && *entry.timeout <= now;
+        };
+
+        for (auto &entry : _idleCallbacks)
+            if (isExpired(entry)) {
+                expired.push_back(std::move(entry));
+                entry.callback = nullptr;
+            }
+        std::erase_if(_idleCallbacks, [](const IdleEntry &entry) { return !entry.callback; });
+    }
+
+    for (auto &entry : expired)
+        entry.callback(IdleDeadline(deadline, true));
+}
+
+} // namespace scheduler
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace scheduler {
+
+using Clock = std::chrono::steady_clock;
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+// Frame phases, highest priority first
+enum class Priority {
+    Input,     // right after event dispatch
+    Animation, // after animation frame callbacks
+    Render,    // before layout and paint, deferred once frame budget is spent
+    Idle       // after present, only within what is left of frame budget
+};
+
+// Given to idle callbacks, like browsers `IdleDeadline`
+class IdleDeadline {
+    Clock::time_point _deadline;
+    bool _didTimeout;
+
+  public:
+    IdleDeadline(Clock::time_point deadline, bool didTimeout);
+
+    // Milliseconds left in current frame, 0 once budget is spent
+    double timeRemaining() const;
+
+    // Callback runs because its timeout expired, whatever is left of the budget
+    bool didTimeout() const;
+};
+
+/**
+ * Splits the work of a frame in priority phases sharing a time budget, after due timers.
+ * Input and animation work always runs in the frame it was posted for, render tasks (at least one)
+ * and idle work only while the budget lasts, the rest is deferred to later frames.
+ * Long work should be split in idle callbacks checking `timeRemaining()` and requesting another
+ * callback to resume. Work posted while a phase runs waits for the next frame.
+ * Posting and cancelling may happen on any thread, phases run on the UI thread.
+ */
+class FrameScheduler {
+  public:
+    using CallbackId = std::uint64_t;
+    using Task = std::function<void()>;
+    // @param timestamp Frame start, in milliseconds since scheduler creation
+    using AnimationCallback = std::function<void(double timestamp)>;
+    using IdleCallback = std::function<void(const IdleDeadline &)>;
+
+  private:
+    struct IdleEntry {
+        CallbackId id;
+        IdleCallback callback;
+        std::optional<Clock::time_point> timeout;
+    };
+
+    struct Timer {
+        CallbackId id;
+        Clock::time_point due;
+        Task task;
+    };
+
+    mutable std::mutex _mutex;
+    std::array<std::deque<Task>, 3> _tasks; // input, animation and render priorities
+    std::vector<std::pair<CallbackId, AnimationCallback>> _animationCallbacks;
+    std::vector<std::pair<CallbackId, AnimationCallback>> _runningAnimationCallbacks; // cancelled ones are reset
+    std::deque<IdleEntry> _idleCallbacks; // by id
+    std::vector<Timer> _timers;
+    CallbackId _nextId;
+    std::function<void()> _wakeUp;
+    Milliseconds _budget;
+    Clock::time_point _origin;
+    Clock::time_point _frameStart;
+
+  public:
+    explicit FrameScheduler(Milliseconds budget = Milliseconds(1000.0 / 60));
+
+    FrameScheduler(const FrameScheduler &) = delete;
+    FrameScheduler &operator=(const FrameScheduler &) = delete;
+
+    void setBudget(Milliseconds budget);
+    Milliseconds getBudget() const;
+
+    // Called on the posting thread whenever work is posted or requested,
+    // so that a loop sleeping until something happens runs the next frame. Set before posting
+    void setWakeUp(std::function<void()> wakeUp);
+
+    // Starts budget of a new frame
+    void beginFrame();
+
+    Clock::time_point getFrameStart() const;
+    Milliseconds getElapsed() const;
+    Milliseconds getRemainingBudget() const;
+
+    // Idle tasks are idle callbacks without timeout
+    void post(Priority priority, Task task);
+
+    // Runs once, in the next animation phase
+    CallbackId requestAnimationFrame(AnimationCallback callback);
+    void cancelAnimationFrame(CallbackId id);
+
+    // Runs once, in an idle phase with budget left or the first one after `timeout`
+    CallbackId requestIdleCallback(IdleCallback callback, std::optional<Milliseconds> timeout = std::nullopt);
+    void cancelIdleCallback(CallbackId id);
+
+    // Runs once, at the start of the first frame after `delay`
+    CallbackId setTimeout(Task task, Milliseconds delay);
+    void clearTimeout(CallbackId id);
+
+    // Any task or callback waiting for a phase, or timer already due : work the next frame would run
+    bool hasPendingWork() const;
+
+    // Earliest timer, loops may sleep until then once no work is pending
+    std::optional<Clock::time_point> getNextTimerDue() const;
+
+    // Timers posted before this call and due, earliest first
+    void runTimers();
+
+    // Input, animation or render tasks posted before this call
+    void runTasks(Priority priority);
+
+    // Animation frame callbacks then animation tasks
+    void runAnimationFrames();
+
+    // Idle callbacks while budget lasts, then those whose timeout expired
+    void runIdle();
+};
+
+} // namespace scheduler
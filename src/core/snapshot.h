@@ -0,0 +1,5 @@
+#pragma once
+
+#include "./snapshot/Frame.h"
+#include "./snapshot/PngWriter.h"
+#include "./snapshot/RawFrameWriter.h"
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace snapshot {
+
+// RGBA8 image read back from a render target : top-down rows, straight alpha
+struct Frame {
+    int width = 0;
+    int height = 0;
+    std::vector<Color> pixels;
+
+    const Color *row(int y) const { return pixels.data() + std::size_t(y) * width; }
+};
+
+} // namespace snapshot
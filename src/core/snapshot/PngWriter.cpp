@@ -0,0 +1,159 @@
+#include "./PngWriter.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace snapshot {
+
+namespace {
+
+// stored deflate block payload limit
+constexpr std::size_t MaxStoredBlock = 65535;
+
+void appendBigEndian(std::vector<unsigned char> &buffer, std::uint32_t value) {
+    buffer.push_back(value >> 24);
+    buffer.push_back(value >> 16);
+    buffer.push_back(value >> 8);
+    buffer.push_back(value);
+}
+
+std::array<std::uint32_t, 256> makeCrcTable() {
+    std::array<std::uint32_t, 256> table;
+    for (std::uint32_t n = 0; n < 256; ++n) {
+        auto c = n;
+        for (int k = 0; k < 8; ++k)
+            c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+        table[n] = c;
+    }
+    return table;
+}
+
+} // namespace
+
+std::uint32_t PngWriter::Crc32(const unsigned char *data, std::size_t size, std::uint32_t crc) {
+    static const auto table = makeCrcTable();
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i)
+        crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+std::uint32_t PngWriter::Adler32(const unsigned char *data, std::size_t size, std::uint32_t adler) {
+    // largest run before sums may overflow 32 bits
+    constexpr std::size_t Run = 5552;
+    std::uint32_t a = adler & 0xffff, b = adler >> 16;
+
+    while (size > 0) {
+        const auto count = std::min(size, Run);
+        for (std::size_t i = 0; i < count; ++i) {
+            a += data[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+        data += count;
+        size -= count;
+    }
+    return (b << 16) | a;
+}
+
+PngWriter::PngWriter(std::ostream &stream, int width, int height)
+    : _stream(stream), _width(width), _height(height), _rowsWritten(0), _adler(1) {
+    _stream.write((const char *)Signature.data(), Signature.size());
+
+    appendBigEndian(_chunk, width);
+    appendBigEndian(_chunk, height);
+    _chunk.push_back(8); // bit depth
+    _chunk.push_back(6); // RGBA
+    _chunk.push_back(0); // deflate
+    _chunk.push_back(0); // adaptive filtering
+    _chunk.push_back(0); // no interlace
+    writeChunk("IHDR");
+
+    // zlib header : deflate with 32K window, no preset dictionary, check bits
+    _chunk.push_back(0x78);
+    _chunk.push_back(0x01);
+}
+
+void PngWriter::writeChunk(const char type[4]) {
+    unsigned char header[8];
+    const auto size = (std::uint32_t)_chunk.size();
+    for (int i = 0; i < 4; ++i) {
+        header[i] = size >> (24 - 8 * i);
+        header[4 + i] = type[i];
+    }
+
+    const auto crc = Crc32(_chunk.data(), _chunk.size(), Crc32(header + 4, 4));
+    unsigned char footer[4];
+    for (int i = 0; i < 4; ++i)
+        footer[i] = crc >> (24 - 8 * i);
+
+    _stream.write((const char *)header, sizeof(header));
+    _stream.write((const char *)_chunk.data(), _chunk.size());
+    _stream.write((const char *)footer, sizeof(footer));
+    _chunk.clear();
+}
+
+void PngWriter::appendStoredBlocks(const unsigned char *data, std::size_t size, bool final) {
+    do {
+        const auto length = std::min(size, MaxStoredBlock);
+        size -= length;
+
+        _chunk.push_back(final && size == 0 ? 1 : 0); // BFINAL, BTYPE 00
+        _chunk.push_back(length);
+        _chunk.push_back(length >> 8);
+        _chunk.push_back(~length);
+        _chunk.push_back(~length >> 8);
+        _chunk.insert(_chunk.end(), data, data + length);
+        data += length;
+    } while (size > 0);
+}
+
+void PngWriter::writeRows(const Color *pixels, int count) {
+    count = std::min(count, _height - _rowsWritten);
+    if (count <= 0)
+        return;
+
+    // scanlines prefixed by filter type, none
+    const auto stride = std::size_t(_width) * 4 + 1;
+    _scanlines.resize(stride * count);
+    for (int y = 0; y < count; ++y) {
+        auto scanline = _scanlines.data() + y * stride;
+        scanline[0] = 0;
+        std::copy_n((const unsigned char *)(pixels + std::size_t(y) * _width), stride - 1, scanline + 1);
+    }
+
+    _adler = Adler32(_scanlines.data(), _scanlines.size(), _adler);
+    appendStoredBlocks(_scanlines.data(), _scanlines.size(), false);
+    writeChunk("IDAT");
+    _rowsWritten += count;
+}
+
+bool PngWriter::finish() {
+    // empty final block then zlib checksum
+    appendStoredBlocks(nullptr, 0, true);
+    appendBigEndian(_chunk, _adler);
+    writeChunk("IDAT");
+    writeChunk("IEND");
+
+    _stream.flush();
+    return _rowsWritten == _height && _stream.good();
+}
+
+bool PngWriter::Write(std::ostream &stream, const Frame &frame, int rowsPerChunk) {
+    PngWriter writer(stream, frame.width, frame.height);
+    for (int y = 0; y < frame.height; y += rowsPerChunk)
+        writer.writeRows(frame.row(y), std::min(rowsPerChunk, frame.height - y));
+    return writer.finish();
+}
+
+bool PngWriter::Write(const std::filesystem::path &path, const Frame &frame, int rowsPerChunk) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        TraceLog(LOG_ERROR, "[PngWriter] Unable to open %s", path.string().c_str());
+        return false;
+    }
+    return Write(file, frame, rowsPerChunk);
+}
+
+} // namespace snapshot
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "./Frame.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <vector>
+
+namespace snapshot {
+
+/**
+ * Streams an RGBA8 PNG while rows are produced, without any compression library :
+ * image data is a zlib stream of stored (uncompressed) deflate blocks,
+ * every `writeRows` call being flushed as its own IDAT chunk.
+ * Files are about the size of raw pixels, encoding being bound by memory bandwidth.
+ */
+class PngWriter {
+    std::ostream &_stream;
+    int _width;
+    int _height;
+    int _rowsWritten;
+    std::uint32_t _adler; // of uncompressed scanlines, closes the zlib stream
+    std::vector<unsigned char> _scanlines; // kept between calls
+    std::vector<unsigned char> _chunk;
+
+    void writeChunk(const char type[4]);
+    void appendStoredBlocks(const unsigned char *data, std::size_t size, bool final);
+
+  public:
+    static constexpr std::array<unsigned char, 8> Signature{137, 'P', 'N', 'G', '\r', '\n', 26, '\n'};
+
+    // Writes signature and header right away
+    PngWriter(std::ostream &stream, int width, int height);
+
+    // Appends `count` top-down rows of `width` pixels
+    void writeRows(const Color *pixels, int count);
+
+    // Closes image data, `false` if some rows are missing or stream failed
+    bool finish();
+
+    static std::uint32_t Crc32(const unsigned char *data, std::size_t size, std::uint32_t crc = 0);
+    static std::uint32_t Adler32(const unsigned char *data, std::size_t size, std::uint32_t adler = 1);
+
+    // Encodes whole frame, `rowsPerChunk` rows at a time
+    static bool Write(std::ostream &stream, const Frame &frame, int rowsPerChunk = 64);
+    static bool Write(const std::filesystem::path &path, const Frame &frame, int rowsPerChunk = 64);
+};
+
+} // namespace snapshot
@@ -0,0 +1,23 @@
+#include "./RawFrameWriter.h"
+
+namespace snapshot {
+
+RawFrameWriter::RawFrameWriter(std::ostream &stream, int width, int height)
+    : _stream(stream), _width(width), _height(height), _frameCount(0) {}
+
+bool RawFrameWriter::write(const Frame &frame) {
+    if (frame.width != _width || frame.height != _height || frame.pixels.size() != std::size_t(_width) * _height) {
+        TraceLog(LOG_ERROR, "[RawFrameWriter] Frame is %dx%d, expected %dx%d", frame.width, frame.height, _width, _height);
+        return false;
+    }
+
+    _stream.write((const char *)frame.pixels.data(), frame.pixels.size() * sizeof(Color));
+    _frameCount++;
+    return _stream.good();
+}
+
+std::uint64_t RawFrameWriter::getFrameCount() const {
+    return _frameCount;
+}
+
+} // namespace snapshot
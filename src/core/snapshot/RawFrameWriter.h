@@ -0,0 +1,30 @@
+#pragma once
+
+#include "./Frame.h"
+
+#include <cstdint>
+#include <ostream>
+
+namespace snapshot {
+
+/**
+ * Writes frames back to back as raw RGBA8 without any header, e.g. into a pipe to
+ * `ffmpeg -f rawvideo -pixel_format rgba -video_size <width>x<height> -i - output.mp4`.
+ * Every frame must have the size given at construction.
+ */
+class RawFrameWriter {
+    std::ostream &_stream;
+    int _width;
+    int _height;
+    std::uint64_t _frameCount;
+
+  public:
+    RawFrameWriter(std::ostream &stream, int width, int height);
+
+    // `false` if frame size does not match or stream failed
+    bool write(const Frame &frame);
+
+    std::uint64_t getFrameCount() const;
+};
+
+} // namespace snapshot
@@ -1,287 +1,218 @@
-#include <algorithm>
+#include <Engine.h>
+#include <event.h>
 #include <memory>
-#include <queue>
-#include <raylib.h>
+#include <profiling.h>
 #include <repository.h>
-#include <stack>
+#include <snapshot.h>
 #include <ui.h>
-#include <unordered_set>
 
-#define WINDOW_WIDTH 640
-#define WINDOW_HEIGHT 480
+#include <cmath>
+#include <optional>
+#include <string>
 
-/*
-def hitTest(rootCtx, point):
-  stack: Stack[(StackingContext, Bool)] = [(rootCtx, false)]
-
-  while !stack.empty():
-    ctx, visited = stack.pop()
-    if !visited:
-      stack.push((ctx, true))
-    else:
-      for e in ctx.elements:
-        if e.contains(point):
-          return e
-      for child in ctx.children.reversed():
-        stack.push(child)
-  return null
-
-def renderCtxTree(rootCtx: StackingContext):
-  stack: Stack[StackingContext] = [rootCtx]
-  clearedLayers: Set[LayerId] = {}
-
-  while !stack.empty():
-    ctx = stack.pop()
-    renderCtx(ctx, clearedLayers)
-#    ctx.children.sort(sortCtxByReverseZIndex)
-    for child in ctx.children.reversed():
-      stack.push(child)
-
-def renderCtx(ctx, clearedLayers):
-  layer = ctx.layer
-  layer.lock()
-  if !clearedLayers.contains(layer.id):
-    layer.clear()
-    clearedLayers.add(layer.id)
-  ctx.owner.render()
-#  ctx.elements.sort(sortElementsByZIndex)
-  for e in ctx.elements:
-    e.render()
-  layer.release()
-
-def compositeLayerTree(rootLayer: Layer):
-  stack: Stack[(Layer, Bool)] = [(rootLayer, false)]
-  while !stack.empty():
-    layer, visited = stack.pop()
-    if !visited:
-      stack.push((layer, true))
-    else:
-      if layer.parent:
-        layer.parent.lock()
-        layer.render() # Apply owner properties then render texture
-        layer.parent.release()
-
-      for child in layer.children:
-        stack.push((child, false))
-
-def renderFrame(rootCtx, rootLayer):
-  renderCtxTree(rootCtx)
-  compositeLayerTree(rootLayer)
-  BeginDrawing()
-  rootLayer.render() # Apply owner properties then render texture
-
-  EndDrawing()
-*/
-
-class Engine {
-    /**
-     * RAII window initialization/destrucation
-     * makes sure to run only after every other attributes have been destroyed
-     */
-    struct WindowInitialization {
-        WindowInitialization() {
-            SetConfigFlags(FLAG_WINDOW_RESIZABLE);
-            InitWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Retained UI with raylib");
-        }
-
-        ~WindowInitialization() {
-            CloseWindow();
-        }
-    };
-
-    WindowInitialization _windowInit; // gets destroyed last
-    std::shared_ptr<ui::element::Root> _elementsRoot;
-    std::shared_ptr<ui::rendering::StackingContext> _stackingContextRoot;
-    std::shared_ptr<ui::rendering::Layer> _layerRoot;
-    std::vector<repository::Repository *> _repositories;
-    bool _requestNewFrame;
-    std::shared_ptr<ui::element::Element> _imgContainer; // TO REMOVE
-
-    // created for debug purposes
-    void _renderElements() {
-        std::queue<std::shared_ptr<ui::element::Element>> queue;
-
-        queue.push(_elementsRoot);
-        while (!queue.empty()) {
-            auto e = queue.front();
-            queue.pop();
-            e->render();
-            for (auto child : e->getChildren())
-                queue.push(child);
-        }
-    }
-
-    void scaffold() {
-        /*
-        Root {
+void scaffold(std::shared_ptr<ui::element::Root> root) {
+    /*
+    Root {
+        View {
+            Rect {}
             View {
-                Rect {}
-                View {
-                    Image {}
-                }
+                Image {}
             }
         }
-        */
-        _elementsRoot = std::make_shared<ui::element::Root>(Vector2{
-            .x = WINDOW_WIDTH,
-            .y = WINDOW_HEIGHT});
-
-        auto view = std::make_shared<ui::element::View>();
-        _elementsRoot->appendChild(view);
-
-        {
-            auto layout = view->getLayout();
-            auto &flex = layout.flex.emplace();
-            flex.justifyContent = ui::style::JustifyContent::Center;
-            flex.alignItems = ui::style::Alignment::Center;
-            flex.flex = 1.0;
-            view->updateLayout(layout);
-        }
-
-        auto rect = std::make_shared<ui::element::View>();
-        view->appendChild(rect);
-        {
-            auto layout = rect->getLayout();
-            auto &size = layout.size.emplace();
-            size.width = utils::Value(64);
-            size.height = utils::Value(64);
-            layout.positionType = ui::style::PositionType::Absolute;
-            auto &position = layout.position.emplace();
-            position.top = utils::Value(0.0f);
-            position.right = utils::Value(0.0f);
-            rect->updateLayout(layout);
-
-            auto style = rect->getStyle();
-            style.backgroundColor = BLUE;
-            style.zIndex = 1;
-            style.isolation = ui::style::IsolationIsolate{};
-            rect->updateStyle(style);
-        }
-
-        auto button = std::make_shared<ui::element::Button>();
-        // ui::element::Element::AppendChild(view, button);
-
-        {
-            auto style = button->getStyle();
-            style.inheritables.fontSize = 24;
-            style.inheritables.color = BROWN;
-            std::vector<std::string> fontFamily;
-            fontFamily.push_back("roboto");
-            style.inheritables.fontFamily = fontFamily;
-            button->updateStyle(style);
-        }
-
-        auto text = std::make_shared<ui::element::Text>("This is a button");
-        button->appendChild(text);
-
-        repository::FontRepository::Get()->load("roboto", "Roboto-Regular.ttf");
-
-        auto imgContainer = std::make_shared<ui::element::View>();
-        _imgContainer = imgContainer;
-        view->appendChild(imgContainer);
-        {
-            auto layout = imgContainer->getLayout();
-            layout.spacing.emplace().border = 3;
-            auto &size = layout.size.emplace();
-            size.width = utils::Ratio(0.9);
-            size.height = utils::Ratio(0.9);
-            imgContainer->updateLayout(layout);
-
-            auto style = imgContainer->getStyle();
-            style.borderColor = WHITE;
-            // auto &transform = style.transform.emplace();
-            // transform.rotation = {utils::AngleRadian(PI/3)};
-            // auto &translation = transform.translation.emplace();
-            /*translation.x = utils::Value<float>(48);
-            translation.y = utils::Value<float>(-48);
-            auto& scale = transform.scale.emplace();
-            scale.x = 0.75;
-            scale.y = 0.75;*/
-
-            imgContainer->updateStyle(style);
-        }
-
-        auto image = std::make_shared<ui::element::Image>("assets/images/cat.png", "cat");
-        imgContainer->appendChild(image);
-        {
-            auto style = image->getStyle();
-            style.opacity = 1;
-            auto &props = *style.drawableContentProps;
-            props.objectFit = ui::style::ObjectFit::ScaleDown;
-            props.objectPosition = ui::style::ObjectPositionCenter{};
-            image->updateStyle(style);
-
-            auto layout = image->getLayout();
-            auto &size = layout.size.emplace();
-            size.width = utils::Ratio(1.0);
-            size.height = utils::Ratio(1.0);
+    }
+    */
+    auto view = std::make_shared<ui::element::View>();
+    root->appendChild(view);
+
+    {
+        auto layout = view->getLayout();
+        auto &flex = layout.flex.emplace();
+        flex.justifyContent = ui::style::JustifyContent::Center;
+        flex.alignItems = ui::style::Alignment::Center;
+        flex.flex = 1.0;
+        view->updateLayout(layout);
+    }
 
-            image->updateLayout(layout);
-        }
+    auto rect = std::make_shared<ui::element::View>();
+    view->appendChild(rect);
+    {
+        auto layout = rect->getLayout();
+        auto &size = layout.size.emplace();
+        size.width = utils::Value(64);
+        size.height = utils::Value(64);
+        layout.positionType = ui::style::PositionType::Absolute;
+        auto &position = layout.position.emplace();
+        position.top = utils::Value(0.0f);
+        position.right = utils::Value(0.0f);
+        rect->updateLayout(layout);
+
+        auto style = rect->getStyle();
+        style.backgroundColor = BLUE;
+        style.zIndex = 1;
+        style.isolation = ui::style::IsolationIsolate{};
+        rect->updateStyle(style);
+    }
 
-        _elementsRoot->finalize();
+    auto button = std::make_shared<ui::element::Button>();
+    // ui::element::Element::AppendChild(view, button);
+
+    {
+        auto style = button->getStyle();
+        style.inheritables.fontSize = 24;
+        style.inheritables.color = BROWN;
+        std::vector<std::string> fontFamily;
+        fontFamily.push_back("roboto");
+        style.inheritables.fontFamily = fontFamily;
+        button->updateStyle(style);
     }
 
-    void render() {
-        BeginDrawing();
-        _stackingContextRoot->renderTree();
-        _layerRoot->composite();
-        _layerRoot->render();
-        EndDrawing();
+    auto text = std::make_shared<ui::element::Text>("This is a button");
+    button->appendChild(text);
+
+    repository::FontRepository::Get()->load("roboto", "Roboto-Regular.ttf");
+
+    auto imgContainer = std::make_shared<ui::element::View>();
+    view->appendChild(imgContainer);
+    {
+        auto layout = imgContainer->getLayout();
+        layout.spacing.emplace().border = 3;
+        auto &size = layout.size.emplace();
+        size.width = utils::Ratio(0.9);
+        size.height = utils::Ratio(0.9);
+        imgContainer->updateLayout(layout);
+
+        auto style = imgContainer->getStyle();
+        style.borderColor = WHITE;
+        // auto &transform = style.transform.emplace();
+        // transform.rotation = {utils::AngleRadian(PI/3)};
+        // auto &translation = transform.translation.emplace();
+        /*translation.x = utils::Value<float>(48);
+        translation.y = utils::Value<float>(-48);
+        auto& scale = transform.scale.emplace();
+        scale.x = 0.75;
+        scale.y = 0.75;*/
+
+        imgContainer->updateStyle(style);
     }
 
-  public:
-    Engine() {
-        _repositories = repository::InitRepositories();
-        scaffold();
+    imgContainer->getEventListeners().add<event::data::Click>([](event::Event &e) {
+        auto target = e.getCurrentTarget();
+        const auto button = e.unwrapData<event::data::Click>().button;
+        auto style = target->getStyle();
 
-        _stackingContextRoot = ui::rendering::StackingContext::BuildTree(_elementsRoot);
-        _layerRoot = ui::rendering::Layer::BuildTree(_stackingContextRoot);
-        _requestNewFrame = true;
+        if (button == MOUSE_BUTTON_LEFT)
+            style.opacity = 0.125;
+        else if (button == MOUSE_BUTTON_RIGHT)
+            style.opacity = 1;
 
-        SetTraceLogLevel(LOG_DEBUG);
-        SetTargetFPS(60);
+        target->updateStyle(style);
+    });
+
+    auto image = std::make_shared<ui::element::Image>("assets/images/cat.png", "cat");
+    imgContainer->appendChild(image);
+    {
+        auto style = image->getStyle();
+        style.opacity = 1;
+        auto &props = *style.drawableContentProps;
+        props.objectFit = ui::style::ObjectFit::ScaleDown;
+        props.objectPosition = ui::style::ObjectPositionCenter{};
+        image->updateStyle(style);
+
+        auto layout = image->getLayout();
+        auto &size = layout.size.emplace();
+        size.width = utils::Ratio(1.0);
+        size.height = utils::Ratio(1.0);
+
+        image->updateLayout(layout);
     }
-
-    ~Engine() {
-        repository::Repository::Clear(_repositories);
+}
+
+int main(int argc, char **argv) {
+#ifdef UI_PROFILING
+    // --trace <file> : write Chrome trace events, started first to cover setup (assets, layers)
+    for (int i = 1; i + 1 < argc; i += 2)
+        if (std::string(argv[i]) == "--trace")
+            profiling::Tracer::Get().start(argv[i + 1]);
+#endif
+
+    // --headless : hidden window, offscreen rendering, --frames <n> : stop after n frames
+    // --fixed-dt <ms> : fixed timestep, --backend <null|recording|software> : paint without window nor GPU
+    // --threaded : UI thread paints command lists presented by the main thread
+    // --ui-threads <n> : resolve inherited styles and lay out layout boundaries on n threads
+    // --frame-budget <ms> : work per frame, idle callbacks get what is left
+    // --continuous : paint every frame instead of on demand, --vsync : pace frames with buffer swaps
+    // --texture-budget <MiB> : evict textures not drawn lately beyond
+    // --bundle <file> : load packed assets from bundle (see tools/pack.cpp), may be repeated
+    Engine::Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string option(argv[i]);
+        if (option == "--headless")
+            options.headless = true;
+        else if (option == "--threaded")
+            options.threadedRendering = true;
+        else if (option == "--continuous")
+            options.renderOnDemand = false;
+        else if (option == "--vsync")
+            options.vsync = true;
+        else if (option == "--ui-threads" && i + 1 < argc)
+            options.uiThreads = std::stoul(argv[++i]);
+        else if (option == "--frame-budget" && i + 1 < argc)
+            options.frameBudget = std::stof(argv[++i]);
+        else if (option == "--texture-budget" && i + 1 < argc)
+            options.textureBudget = std::stoull(argv[++i]) << 20;
+        else if (option == "--bundle" && i + 1 < argc)
+            options.bundles.emplace_back(argv[++i]);
+        else if (option == "--frames" && i + 1 < argc)
+            options.frameCount = std::stoull(argv[++i]);
+        else if (option == "--fixed-dt" && i + 1 < argc)
+            options.fixedTimestep = std::stoul(argv[++i]);
+        else if (option == "--backend" && i + 1 < argc) {
+            const std::string backend(argv[++i]);
+            if (backend == "null")
+                options.backend = Engine::Backend::Null;
+            else if (backend == "recording")
+                options.backend = Engine::Backend::Recording;
+            else if (backend == "software")
+                options.backend = Engine::Backend::Software;
+        }
     }
 
-    void run() {
-        while (!WindowShouldClose()) {
-            if (IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) {
-                auto style = _imgContainer->getStyle();
-                style.opacity = 0.125;
-                _imgContainer->updateStyle(style);
-            } else if (IsMouseButtonReleased(MOUSE_BUTTON_RIGHT)) {
-                auto style = _imgContainer->getStyle();
-                style.opacity = 1;
-                _imgContainer->updateStyle(style);
-            }
-            
-            if (IsWindowResized()) {
-                _elementsRoot->onWindowResized(GetScreenWidth(), GetScreenHeight());
-            }
+    // TEST PLAYGROUND
+    Engine engine(options);
+    scaffold(engine.getRoot());
+
+    // --record <file> : save input stream, --replay <file> : feed it back with a fixed timestep
+    // --render-stats : log rendering counters once per second
+    // --snapshot <file.png> : write a single frame then exit, --snapshot-scale <factor> : output pixels per layout unit
+    std::optional<std::string> snapshotPath;
+    Engine::SnapshotOptions snapshotOptions;
+    for (int i = 1; i < argc; ++i) {
+        const std::string option(argv[i]);
+        if (option == "--render-stats")
+            engine.logRenderStats(true);
+        else if (option == "--record" && i + 1 < argc)
+            engine.recordInput(argv[++i]);
+        else if (option == "--replay" && i + 1 < argc)
+            engine.replayInput(argv[++i]);
+        else if (option == "--snapshot" && i + 1 < argc)
+            snapshotPath = argv[++i];
+        else if (option == "--snapshot-scale" && i + 1 < argc)
+            snapshotOptions.scale = std::stof(argv[++i]);
+    }
 
-            // update inherited properties
-            // and check for layout dirty flag
-            _elementsRoot->update();
+    if (snapshotPath) {
+        snapshotOptions.width = std::lround(options.width * snapshotOptions.scale);
+        snapshotOptions.height = std::lround(options.height * snapshotOptions.scale);
 
-            if (_requestNewFrame) {
-                render();
-                // _requestNewFrame = false;
-            } else {
-                // prevent window from freezing
-                PollInputEvents();
-            }
-        }
+        snapshot::Frame frame;
+        const auto written = engine.snapshot(snapshotOptions, frame) && snapshot::PngWriter::Write(*snapshotPath, frame);
+        return written ? 0 : 1;
     }
-};
 
-int main() {
-    // TEST PLAYGROUND
-    Engine engine;
     engine.run();
+#ifdef UI_PROFILING
+    profiling::Tracer::Get().stop();
+#endif
 
     return 0;
-}
\ No newline at end of file
+}
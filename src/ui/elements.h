@@ -6,5 +6,7 @@
 #include "./elements/Row.h"
 #include "./elements/Stack.h"
 #include "./elements/Text.h"
+#include "./elements/TextDocument.h"
 #include "./elements/View.h"
-#include "./elements/Image.h"
\ No newline at end of file
+#include "./elements/Image.h"
+#include "./elements/ProfilerOverlay.h"
\ No newline at end of file
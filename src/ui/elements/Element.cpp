@@ -1,9 +1,12 @@
 #include "./Element.h"
 
+#include "../../core/event/EventListeners.h"
+#include "../../core/profiling/Tracer.h"
 #include "../../utils/functions.h"
 #include "../../utils/operators.h"
 #include "../defaults.h"
 #include "../rendering/Layer.h"
+#include "../rendering/backend/DrawBackend.h"
 #include "../rendering/StackingContext.h"
 
 #include <yoga/YGNodeLayout.h>
@@ -19,7 +22,7 @@ namespace element {
 Element::ElementId Element::nextId = 0;
 
 Element::Element(const std::string &name)
-    : _preferredTheme(ui::style::Theme::Dark), _name(name), _dirtyCachedInheritableProps(true) {
+    : _placeholderNode(nullptr), _preferredTheme(ui::style::Theme::Dark), _name(name), _dirtyCachedInheritableProps(true) {
     _id = nextId++;
     _yogaNode = YGNodeNew();
     updateStyle(ui::defaults::elementStyles(_preferredTheme));
@@ -27,6 +30,8 @@ Element::Element(const std::string &name)
 }
 
 Element::~Element() {
+    if (_placeholderNode)
+        YGNodeFree(_placeholderNode);
     YGNodeFree(_yogaNode);
 }
 
@@ -60,6 +65,8 @@ void Element::onChildAppended(std::shared_ptr<Element>) { /* Do nothing */ }
 
 void Element::onLayoutDirtyFlagTriggered() { /* Do nothing */ }
 
+void Element::onPaintDirtyFlagTriggered() { /* Do nothing */ }
+
 void Element::onDirtyCachedInheritableStylesTriggered() { /* Do nothing */ }
 
 void Element::onPreferredThemeChanged(ui::style::Theme theme) {
@@ -101,6 +108,13 @@ void Element::markLayoutAsDirty() {
         parent->onLayoutDirtyFlagTriggered();
 }
 
+void Element::markPaintAsDirty() {
+    onPaintDirtyFlagTriggered();
+
+    for (auto parent = _parent.lock(); parent; parent = parent->getParent())
+        parent->onPaintDirtyFlagTriggered();
+}
+
 Element &Element::appendChild(std::shared_ptr<Element> child) {
     auto &self = *this;
     if (!child)
@@ -116,7 +130,8 @@ Element &Element::appendChild(std::shared_ptr<Element> child) {
 
     _children.push_back(child);
     child->setParent(shared_from_this());
-    YGNodeInsertChild(_yogaNode, child->_yogaNode, _children.size() - 1);
+    YGNodeInsertChild(_yogaNode, child->getOuterYogaNode(), _children.size() - 1);
+    markLayoutAsDirty();
     onChildAppended(child);
 
     return self;
@@ -125,9 +140,10 @@ Element &Element::appendChild(std::shared_ptr<Element> child) {
 void Element::removeChild(std::shared_ptr<Element> child) {
     auto it = std::find(_children.begin(), _children.end(), child);
     if (it != _children.end()) {
-        YGNodeRemoveChild(_yogaNode, child->_yogaNode);
+        YGNodeRemoveChild(_yogaNode, child->getOuterYogaNode());
         (*it)->_parent.reset();
         _children.erase(it);
+        markLayoutAsDirty();
 
         onChildRemoved(child);
     }
@@ -136,6 +152,50 @@ void Element::removeChild(std::shared_ptr<Element> child) {
 void Element::removeAllChildren() {
     YGNodeRemoveAllChildren(_yogaNode);
     _children.clear();
+    markLayoutAsDirty();
+}
+
+YGNodeRef Element::getOuterYogaNode() const {
+    return _placeholderNode ? _placeholderNode : _yogaNode;
+}
+
+bool Element::isLayoutBoundary() const {
+    return _placeholderNode != nullptr;
+}
+
+void Element::setLayoutBoundary(bool boundary) {
+    if (boundary == isLayoutBoundary())
+        return;
+
+    if (boundary) {
+        auto size = _layout.size.value_or(ui::style::Size{});
+        auto isFixed = [](const auto &dimension) {
+            return dimension && std::holds_alternative<utils::Value<int>>(*dimension);
+        };
+        if (!isFixed(size.width) || !isFixed(size.height))
+            TraceLog(LOG_WARNING, "[Element] Layout boundary '%s' has no fixed size", _name.c_str());
+    }
+
+    // swap nodes in parent Yoga tree, at the same index
+    auto parent = getParent();
+    std::size_t index = 0;
+    if (parent) {
+        auto it = std::find(parent->_children.begin(), parent->_children.end(), shared_from_this());
+        index = it - parent->_children.begin();
+        YGNodeRemoveChild(parent->_yogaNode, getOuterYogaNode());
+    }
+
+    if (boundary) {
+        _placeholderNode = YGNodeNew();
+        YGNodeCopyStyle(_placeholderNode, _yogaNode);
+    } else {
+        YGNodeFree(_placeholderNode);
+        _placeholderNode = nullptr;
+    }
+
+    if (parent)
+        YGNodeInsertChild(parent->_yogaNode, getOuterYogaNode(), index);
+    markLayoutAsDirty();
 }
 
 Vector2 Element::getPosition() const {
@@ -156,10 +216,11 @@ bool Element::contains(const Vector2 &point) const {
     return CheckCollisionPointRec(point, rect);
 }
 
-Rectangle Element::getFinalBoundingRect() const {
-    const auto bb = getBoundingRect();
+std::optional<Element::ResolvedTransform> Element::getResolvedTransform() const {
     if (!_style.transform.has_value())
-        return bb;
+        return std::nullopt;
+
+    const auto bb = getBoundingRect();
 
     Vector2 origin;
     if (std::holds_alternative<style::TransformOriginCenter>(_style.transformOrigin)) {
@@ -210,12 +271,22 @@ Rectangle Element::getFinalBoundingRect() const {
         }
     }
 
-    return utils::getBoundsOfTransformedRect(bb, origin, rotationAngle, scale, translation);
+    return ResolvedTransform{.origin = origin, .rotation = rotationAngle, .scale = scale, .translation = translation};
+}
+
+Rectangle Element::getFinalBoundingRect() const {
+    const auto bb = getBoundingRect();
+    const auto transform = getResolvedTransform();
+    if (!transform)
+        return bb;
+
+    return utils::getBoundsOfTransformedRect(bb, transform->origin, transform->rotation, transform->scale, transform->translation);
 }
 
 Rectangle Element::getBoundingRect() const {
-    Rectangle bb = {.x = YGNodeLayoutGetLeft(_yogaNode),
-                    .y = YGNodeLayoutGetTop(_yogaNode),
+    // a layout boundary is placed by parent tree but laid out as a root
+    Rectangle bb = {.x = YGNodeLayoutGetLeft(getOuterYogaNode()),
+                    .y = YGNodeLayoutGetTop(getOuterYogaNode()),
                     .width = YGNodeLayoutGetWidth(_yogaNode),
                     .height = YGNodeLayoutGetHeight(_yogaNode)};
     return bb;
@@ -255,6 +326,10 @@ style::Layout Element::getLayout() const {
     return _layout;
 }
 
+const style::Inheritables &Element::getCachedInheritableProps() const {
+    return _cachedInheritableProps;
+}
+
 void Element::updateStyle(const style::Style &style) {
     if (style.inheritables != _style.inheritables) {
         _cachedInheritableProps = style.inheritables;
@@ -264,9 +339,11 @@ void Element::updateStyle(const style::Style &style) {
     auto tmp = _style;
     _style = style;
     checkForStackingContextAndLayerUpdate(tmp);
+    markPaintAsDirty();
 }
 
 void Element::checkForStackingContextAndLayerUpdate(const style::Style &oldStyle) {
+    TRACE_ZONE("StackingContextUpdate");
     auto ctx = _stackingContext.lock();
     if (!ctx)
         return;
@@ -421,6 +498,10 @@ void Element::updateLayout(const style::Layout &layout) {
     if (auto boxSizing = layout.boxSizing)
         updateBoxSizing(*boxSizing);
 
+    // placeholder takes part in parent layout with the same styles
+    if (_placeholderNode)
+        YGNodeCopyStyle(_placeholderNode, _yogaNode);
+
     markLayoutAsDirty();
     _layout = layout;
 }
@@ -676,16 +757,16 @@ void Element::drawBackground(const Rectangle &bb) {
         if (auto radius = _style.borderRadius) {
             if (auto ratio = std::get_if<utils::Ratio>(&*radius)) {
                 auto radius = utils::clampRatio(ratio->ratio);
-                DrawRectangleRounded(bb, radius, getSegmentCount(radius), *bg);
+                ui::rendering::backend::DrawBackend::Get().drawRectangleRounded(bb, radius, getSegmentCount(radius), *bg);
             }
 
             if (auto value = std::get_if<utils::Value<float>>(&*radius)) {
                 auto radius =
                     utils::clampRatio(value->value / std::min(bb.width, bb.height));
-                DrawRectangleRounded(bb, radius, getSegmentCount(radius), *bg);
+                ui::rendering::backend::DrawBackend::Get().drawRectangleRounded(bb, radius, getSegmentCount(radius), *bg);
             }
         } else {
-            DrawRectangle(bb.x, bb.y, bb.width, bb.height, *bg);
+            ui::rendering::backend::DrawBackend::Get().drawRectangle(bb, *bg);
         }
     }
 }
@@ -717,15 +798,15 @@ void Element::drawBorder(const Rectangle &bb) {
 
                 if (auto ratio = std::get_if<utils::Ratio>(&*radius)) {
                     auto radius = utils::clampRatio(ratio->ratio);
-                    DrawRectangleRoundedLines(rect, radius, getSegmentCount(radius),
-                                              *border, *borderColor);
+                    ui::rendering::backend::DrawBackend::Get().drawRectangleRoundedLines(rect, radius, getSegmentCount(radius),
+                                                                                         *border, *borderColor);
                 }
 
                 if (auto value = std::get_if<utils::Value<float>>(&*radius)) {
                     auto radius =
                         utils::clampRatio(value->value / std::min(rect.width, rect.height));
-                    DrawRectangleRoundedLines(rect, radius, getSegmentCount(radius),
-                                              *border, *borderColor);
+                    ui::rendering::backend::DrawBackend::Get().drawRectangleRoundedLines(rect, radius, getSegmentCount(radius),
+                                                                                         *border, *borderColor);
                 }
 
                 drawRoundedBorders = true;
@@ -788,12 +869,12 @@ void Element::drawBorder(const Rectangle &bb) {
                 .y = bb.y - halfBorder,
                 .width = bb.width + halfBorder,
                 .height = bb.height + halfBorder};
-            DrawRectangleLinesEx(rect, border, finalColors.top);
+            ui::rendering::backend::DrawBackend::Get().drawRectangleLines(rect, border, finalColors.top);
         } else
-            utils::drawRectangle(bb, finalBorders.top, finalBorders.bottom,
-                                 finalBorders.left, finalBorders.right, finalColors.top,
-                                 finalColors.bottom, finalColors.left,
-                                 finalColors.right);
+            ui::rendering::backend::DrawBackend::Get().drawRectangleEdges(bb, finalBorders.top, finalBorders.bottom,
+                                                                          finalBorders.left, finalBorders.right, finalColors.top,
+                                                                          finalColors.bottom, finalColors.left,
+                                                                          finalColors.right);
     }
 }
 
@@ -842,6 +923,16 @@ void Element::setPreferredTheme(ui::style::Theme theme) {
     }
 }
 
+event::EventListeners &Element::getEventListeners() {
+    if (!_eventListeners)
+        _eventListeners = std::make_unique<event::EventListeners>();
+    return *_eventListeners;
+}
+
+event::EventListeners *Element::findEventListeners() const {
+    return _eventListeners.get();
+}
+
 void Element::setParent(std::shared_ptr<Element> parent) {
     _parent = parent;
     setPreferredTheme(parent->getPreferredTheme());
@@ -13,6 +13,10 @@
 #include "../styles/Style.h"
 #include "../styles/Theme.h"
 
+namespace event { // forward declaration
+class EventListeners;
+} // namespace event
+
 namespace ui {
 
 namespace rendering { // forward declarations
@@ -36,6 +40,7 @@ class Element : public std::enable_shared_from_this<Element> {
     ui::style::Layout _layout;
     ui::style::Style _style;
     YGNodeRef _yogaNode;
+    YGNodeRef _placeholderNode; // stands for this element in parent Yoga tree while a layout boundary
     ElementId _id;
     ui::style::Theme _preferredTheme;
     std::string _name;         // name of this element
@@ -44,6 +49,7 @@ class Element : public std::enable_shared_from_this<Element> {
     std::vector<std::shared_ptr<Element>> _children;
     bool _dirtyCachedInheritableProps;
     ui::style::Inheritables _cachedInheritableProps;
+    std::unique_ptr<event::EventListeners> _eventListeners; // created on first listener registration
 
   protected:
     Element(const std::string &name = "Element");
@@ -58,6 +64,9 @@ class Element : public std::enable_shared_from_this<Element> {
     void updateSize(const ui::style::Size &size);
     void updateCachedInheritablePropsFrom(std::shared_ptr<Element> element);
 
+    // Node inserted in parent Yoga tree
+    YGNodeRef getOuterYogaNode() const;
+
   protected:
     // used by AppendChild methods
     void setParent(std::shared_ptr<Element> parent);
@@ -67,6 +76,8 @@ class Element : public std::enable_shared_from_this<Element> {
     int getSegmentCount(float radius) const;
     void markInheritableStylesAsDirty();
     void markLayoutAsDirty();
+    // Next frame has to be painted, for changes affecting neither layout nor inherited styles
+    void markPaintAsDirty();
 
     // Perform checks after style update
     void checkForStackingContextAndLayerUpdate(const ui::style::Style& oldStyle);
@@ -78,6 +89,7 @@ class Element : public std::enable_shared_from_this<Element> {
     virtual void onChildRemoved(std::shared_ptr<Element> child);
     virtual void onDirtyCachedInheritableStylesTriggered();
     virtual void onLayoutDirtyFlagTriggered();
+    virtual void onPaintDirtyFlagTriggered();
 
   protected:
     void drawBackground(const Rectangle &rect);
@@ -100,6 +112,11 @@ class Element : public std::enable_shared_from_this<Element> {
     void removeChild(std::shared_ptr<Element> child);
     void removeAllChildren();
 
+    // A layout boundary has its own Yoga tree, laid out once parent tree is (concurrently with other
+    // boundaries when root has several threads). Its size should be fixed : children never resize it.
+    void setLayoutBoundary(bool boundary);
+    bool isLayoutBoundary() const;
+
     // Dirty flag won't be broadcast if this element does not have a parent element.
     // Atempting to update inner node directly instead of calling this function will cause
     // undefined behavior in dirty layout detection
@@ -134,6 +151,9 @@ class Element : public std::enable_shared_from_this<Element> {
 
     ui::style::Style getStyle() const;
 
+    // Inheritable styles resolved by last propagation
+    const ui::style::Inheritables &getCachedInheritableProps() const;
+
     std::shared_ptr<Element> getParent() const;
 
     std::vector<std::shared_ptr<Element>> getChildren();
@@ -144,6 +164,17 @@ class Element : public std::enable_shared_from_this<Element> {
     // Might be invalid if called before layout calculation
     Rectangle getBoundingRect() const;
 
+    // Transform resolved against bounding rect, `origin` being relative to it
+    struct ResolvedTransform {
+        Vector2 origin;
+        float rotation; // radians
+        Vector2 scale;
+        Vector2 translation;
+    };
+
+    // Nothing if element has no transform
+    std::optional<ResolvedTransform> getResolvedTransform() const;
+
     // Returns bounding box of this element bounding rect after transformation (scale, translation, rotation)
     Rectangle getFinalBoundingRect() const;
 
@@ -157,6 +188,12 @@ class Element : public std::enable_shared_from_this<Element> {
 
     ui::style::Theme getPreferredTheme() const;
 
+    // Listener table of this element, created on first call
+    event::EventListeners &getEventListeners();
+
+    // Returns nullptr if no listener table has been created for this element
+    event::EventListeners *findEventListeners() const;
+
     friend class Root;
 };
 
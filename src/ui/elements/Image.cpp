@@ -2,6 +2,7 @@
 #include "../defaults.h"
 #include "../icons.h"
 #include "../core/repository/TextureRepository.h"
+#include "../rendering/backend/DrawBackend.h"
 #include "../utils/debug.h"
 
 namespace ui {
@@ -17,10 +18,12 @@ Image::Image(const std::string &src, const std::string &alt) : Element("Image"),
 
     updateStyle(ui::defaults::imageStyles());
 
-    std::optional<Texture2D> texture = textures->get(src);
+    _texture = textures->resolve(src);
+    textures->retain(_texture);
+    std::optional<Texture2D> texture = textures->get(_texture);
     if (!texture) {
         if (textures->load(src, src))
-            texture = textures->get(src);
+            texture = textures->get(_texture);
     }
 
     if (texture)
@@ -28,8 +31,10 @@ Image::Image(const std::string &src, const std::string &alt) : Element("Image"),
 }
 
 Image::~Image() {
+    if (repository::TextureRepository::Exists())
+        repository::TextureRepository::Get()->release(_texture);
     if (_iconTexture)
-        UnloadTexture(*_iconTexture);
+        ui::rendering::backend::DrawBackend::Get().unloadTexture(*_iconTexture);
 }
 
 void Image::onChildAppended(std::shared_ptr<Element>) {
@@ -43,7 +48,7 @@ void Image::loadAltImageIconTexture() {
         return;
 
     auto icon = LoadImageFromMemory(".png", ui::icon::ImagePng, ui::icon::ImagePngLen);
-    _iconTexture = LoadTextureFromImage(icon);
+    _iconTexture = ui::rendering::backend::DrawBackend::Get().loadTexture(icon);
     UnloadImage(icon);
 }
 
@@ -55,8 +60,14 @@ void Image::render(const Vector2& offset) {
         throw std::logic_error(errorMessage);
     }
 
-    auto optTexture = textures->get(_src);
+    auto optTexture = textures->get(_texture);
+    if (!optTexture && textures->isStale(_texture)) { // replaced or unloaded since resolved
+        _texture = textures->refresh(_texture);
+        optTexture = textures->get(_texture);
+    }
+
     if (!optTexture) {
+        textures->request(_texture); // evicted, shown once reloaded
         loadAltImageIconTexture();
         drawAlt(offset);
         return;
@@ -115,9 +126,9 @@ void Image::render(const Vector2& offset) {
         } break;
         }
 
-        DrawTexturePro(texture, src, dest, {0}, 0.0, WHITE);
+        ui::rendering::backend::DrawBackend::Get().drawTexture(texture, src, dest, {0}, 0.0, WHITE);
     } else {
-        DrawTexture(texture, bb.x, bb.y, WHITE);
+        ui::rendering::backend::DrawBackend::Get().drawTexture(texture, {bb.x, bb.y}, WHITE);
     }
 }
 
@@ -128,8 +139,9 @@ void Image::drawAlt(const Vector2& offset) {
     bb.y += offset.y;
     const int margin = 8;
 
-    DrawTexture(*_iconTexture, bb.x, bb.y, WHITE);
-    DrawText(_alt.c_str(), bb.x + _iconTexture->width + margin, bb.y, 16, _altColor);
+    auto &backend = ui::rendering::backend::DrawBackend::Get();
+    backend.drawTexture(*_iconTexture, {bb.x, bb.y}, WHITE);
+    backend.drawText(nullptr, _alt.c_str(), {bb.x + _iconTexture->width + margin, bb.y}, 16, 0.0, _altColor);
 }
 
 void Image::repositionDrawingRectangles(Rectangle &src, Rectangle &dest, const float scale) {
@@ -196,9 +208,19 @@ void Image::repositionDrawingRectangles(Rectangle &src, Rectangle &dest, const f
     // std::cout << "src : " << src.x << ", " << src.y << ", " << src.width << ", " << src.height << std::endl;
 }
 
-void Image::setSource(const std::string &src) { _src = src; }
+void Image::setSource(const std::string &src) {
+    _src = src;
+    auto textures = repository::TextureRepository::Get();
+    textures->release(_texture);
+    _texture = textures->resolve(src);
+    textures->retain(_texture);
+    markPaintAsDirty();
+}
 
-void Image::setAlt(const std::string &alt) { _alt = alt; }
+void Image::setAlt(const std::string &alt) {
+    _alt = alt;
+    markPaintAsDirty();
+}
 
 std::string Image::getSource() const { return _src; }
 
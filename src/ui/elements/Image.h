@@ -4,6 +4,7 @@
 #include <raylib.h>
 #include <string>
 
+#include "../../core/repository/Handle.h"
 #include "./Element.h"
 
 namespace ui {
@@ -11,6 +12,7 @@ namespace element {
 
 class Image : public Element {
     std::string _src; // source image
+    repository::TextureHandle _texture; // resolved once from `_src`
     std::string _alt; // text to show if image file doesn't exist
     const Color _altColor;
     std::optional<Texture2D> _iconTexture;
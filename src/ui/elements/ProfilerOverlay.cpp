@@ -0,0 +1,74 @@
+#include "./ProfilerOverlay.h"
+#include "../../core/profiling/Profiler.h"
+#include "../rendering/backend/DrawBackend.h"
+
+#include <format>
+
+namespace ui {
+namespace element {
+
+namespace {
+constexpr int Padding = 4;
+constexpr int Width = 220;
+constexpr int LineCount = profiling::PhaseCount + 2; // header, phases, whole frame
+} // namespace
+
+ProfilerOverlay::ProfilerOverlay() : Element("ProfilerOverlay"), _lastRefresh(-RefreshInterval) {
+    auto layout = getLayout();
+    layout.positionType = ui::style::PositionType::Absolute;
+    auto &position = layout.position.emplace();
+    position.top = utils::Value(0.0f);
+    position.left = utils::Value(0.0f);
+    auto &size = layout.size.emplace();
+    size.width = utils::Value(Width);
+    size.height = utils::Value(LineCount * FontSize + 2 * Padding);
+    updateLayout(layout);
+
+    auto style = getStyle();
+    style.backgroundColor = Color{0, 0, 0, 160};
+    style.zIndex = 1000;
+    updateStyle(style);
+}
+
+void ProfilerOverlay::refresh() {
+    _lines.clear();
+
+#ifdef UI_PROFILING
+    const auto stats = profiling::Profiler::Get().getStats();
+    _lines.push_back(std::format("{:<10}{:>8}{:>8}{:>8}", "ms", "min", "avg", "p99"));
+    for (std::size_t phase = 0; phase <= profiling::PhaseCount; ++phase) {
+        const auto &s = stats[phase];
+        _lines.push_back(std::format("{:<10}{:>8.2f}{:>8.2f}{:>8.2f}", profiling::GetPhaseName(static_cast<profiling::Phase>(phase)), s.min, s.avg, s.p99));
+    }
+#else
+    _lines.push_back("Profiling disabled");
+    _lines.push_back("(build with RETAINED_UI_PROFILING)");
+#endif
+}
+
+void ProfilerOverlay::render(const Vector2 &offset) {
+    Element::render(offset);
+
+    const auto now = GetTime();
+    if (now - _lastRefresh >= RefreshInterval) {
+        refresh();
+        _lastRefresh = now;
+    }
+
+    const auto bb = getBoundingRect();
+    auto &backend = ui::rendering::backend::DrawBackend::Get();
+    for (std::size_t i = 0; i < _lines.size(); ++i)
+        backend.drawText(nullptr, _lines[i].c_str(), Vector2{offset.x + bb.x + Padding, offset.y + bb.y + Padding + i * FontSize}, FontSize, 0.0, GREEN);
+
+    // stats only move while frames are produced
+    markPaintAsDirty();
+}
+
+void ProfilerOverlay::onChildAppended(std::shared_ptr<Element>) {
+    const std::string errorMessage("[ProfilerOverlay] ProfilerOverlay element can only be used as leaf node.");
+    TraceLog(LOG_ERROR, errorMessage.c_str());
+    throw std::logic_error(errorMessage);
+}
+
+} // namespace element
+} // namespace ui
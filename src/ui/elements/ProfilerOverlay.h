@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "./Element.h"
+
+namespace ui {
+namespace element {
+
+/**
+ * Draws frame-phase statistics collected by `profiling::Profiler` (min/avg/p99 in milliseconds).
+ * Meant to be appended to the root : positioned absolutely on top-left corner and drawn above siblings.
+ * Shows a notice when built without profiling support.
+ */
+class ProfilerOverlay : public Element {
+    std::vector<std::string> _lines;
+    double _lastRefresh;
+
+    void refresh();
+
+    void onChildAppended(std::shared_ptr<Element>) override;
+
+  public:
+    static constexpr int FontSize = 10;
+    static constexpr double RefreshInterval = 0.25; // seconds
+
+    ProfilerOverlay();
+
+    void render(const Vector2 &) override;
+};
+
+} // namespace element
+} // namespace ui
@@ -1,9 +1,14 @@
 #include "./Root.h"
+#include "../../core/WorkStealingPool.h"
+#include "../../core/profiling/Profiler.h"
 #include "../defaults.h"
 
 #include "../rendering.h"
 
+#include <yoga/YGNodeLayout.h>
+
 #include <queue>
+#include <utility>
 
 namespace ui {
 namespace element {
@@ -50,11 +55,21 @@ void Root::propagatePreferredTheme() {
 
 void Root::onLayoutDirtyFlagTriggered() {
     _dirtyLayout = true;
+    _dirtyPaint = true;
 }
 
 void Root::onDirtyCachedInheritableStylesTriggered() {
     propagateStyles();
     _dirtyCachedInheritableProps = false; // indicate we have cleared that flag
+    _dirtyPaint = true;
+}
+
+void Root::onPaintDirtyFlagTriggered() {
+    _dirtyPaint = true;
+}
+
+bool Root::needsRepaint() const {
+    return _dirtyPaint || _dirtyLayout || _dirtyCachedInheritableProps;
 }
 
 void Root::onPreferredThemeChanged(ui::style::Theme theme) {
@@ -63,11 +78,102 @@ void Root::onPreferredThemeChanged(ui::style::Theme theme) {
 }
 
 void Root::calculateLayout() {
+    PROFILE_PHASE(profiling::Phase::Layout);
     YGNodeCalculateLayout(_yogaNode, YGUndefined, YGUndefined, YGDirectionLTR);
+
+    // Yoga trees of boundaries share no node, only the config
+    if (_pool)
+        _pool->run([this] { calculateBoundariesLayout(*this); });
+    else
+        calculateBoundariesLayout(*this);
+
     _dirtyLayout = false;
 }
 
+void Root::calculateBoundariesLayout(Element &layoutRoot) {
+    std::vector<Element *> stack;
+    for (auto &child : layoutRoot._children)
+        stack.push_back(child.get());
+
+    while (!stack.empty()) {
+        auto node = stack.back();
+        stack.pop_back();
+
+        if (!node->_placeholderNode) {
+            for (auto &child : node->_children)
+                stack.push_back(child.get());
+            continue;
+        }
+
+        // placeholder has been sized by enclosing tree
+        auto layoutBoundary = [this, node] {
+            YGNodeCalculateLayout(node->_yogaNode, YGNodeLayoutGetWidth(node->_placeholderNode),
+                                  YGNodeLayoutGetHeight(node->_placeholderNode), YGDirectionLTR);
+            calculateBoundariesLayout(*node);
+        };
+
+        if (_pool)
+            _pool->spawn(layoutBoundary);
+        else
+            layoutBoundary();
+    }
+}
+
+void Root::setThreadCount(std::size_t threadCount) {
+    if (threadCount == getThreadCount())
+        return;
+
+    _pool = threadCount > 1 ? std::make_unique<WorkStealingPool>(threadCount) : nullptr;
+}
+
+std::size_t Root::getThreadCount() const {
+    return _pool ? _pool->getThreadCount() : 1;
+}
+
+void Root::propagateStylesInParallel() {
+    // [element, parent], each task only writes elements it pops
+    using Pending = std::vector<std::pair<Element *, const Element *>>;
+
+    std::function<void(Pending)> resolve = [this, &resolve](Pending pending) {
+        std::size_t resolved = 0;
+        while (!pending.empty()) {
+            // oldest entries are the shallowest, thus biggest, subtrees
+            if (resolved >= StyleTaskGrain && pending.size() > 1) {
+                const auto half = pending.begin() + pending.size() / 2;
+                Pending split(pending.begin(), half);
+                pending.erase(pending.begin(), half);
+                _pool->spawn([&resolve, split = std::move(split)] { resolve(split); });
+                resolved = 0;
+            }
+
+            auto [node, parent] = pending.back();
+            pending.pop_back();
+            if (!node->_dirtyCachedInheritableProps)
+                continue;
+
+            node->_cachedInheritableProps.updateInheritedFields(node->_style.inheritables, parent->_cachedInheritableProps);
+            node->_dirtyCachedInheritableProps = false;
+            resolved++;
+
+            for (auto &child : node->_children)
+                pending.emplace_back(child.get(), node);
+        }
+    };
+
+    Pending roots;
+    for (auto &child : _children)
+        roots.emplace_back(child.get(), this);
+    _pool->run([&resolve, &roots] { resolve(std::move(roots)); });
+}
+
 void Root::propagateStyles() {
+    PROFILE_PHASE(profiling::Phase::Styles);
+    if (_pool && _dirtyCachedInheritableProps) {
+        propagateStylesInParallel();
+        _dirtyCachedInheritableProps = false;
+        return;
+    }
+
     std::queue<std::shared_ptr<Element>> queue;
     auto self = shared_from_this();
     queue.push(self);
@@ -90,6 +196,18 @@ void Root::propagateStyles() {
     _dirtyCachedInheritableProps = false;
 }
 
+void Root::invalidateStyles() {
+    std::vector<Element *> stack{this};
+    while (!stack.empty()) {
+        auto node = stack.back();
+        stack.pop_back();
+
+        node->_dirtyCachedInheritableProps = true;
+        for (auto &child : node->_children)
+            stack.push_back(child.get());
+    }
+}
+
 void Root::update() {
     if (_dirtyLayout)
         calculateLayout();
@@ -114,6 +232,8 @@ void Root::render(const Vector2& offset) {
         throw std::logic_error(errorMessage);
     }
 
+    // elements painted from now on may invalidate next frame
+    _dirtyPaint = false;
     Element::render(offset);
 }
 
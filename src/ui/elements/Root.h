@@ -5,21 +5,34 @@
 
 #include <memory>
 
+class WorkStealingPool; // forward declaration
+
 namespace ui {
 namespace element {
 
 class Root : public Element {
+  public:
+    // Elements resolved by a style task before it hands half of its pending subtrees over
+    static constexpr std::size_t StyleTaskGrain = 512;
+
+  private:
     YGConfigRef _config;
     bool _finalized = false;
     bool _dirtyLayout = true; // should calculate layout at least once
+    bool _dirtyPaint = true;  // cleared when root gets painted
+    std::unique_ptr<WorkStealingPool> _pool; // `nullptr` when working on calling thread only
 
-    void calculateLayout();
-    void propagateStyles();
     void propagatePreferredTheme();
+    void propagateStylesInParallel();
+
+    // Lays out layout boundaries nested in `layoutRoot` (not in other boundaries),
+    // once `layoutRoot` itself is laid out. Each boundary is a pool task when root has one
+    void calculateBoundariesLayout(Element &layoutRoot);
 
   private:
     void onLayoutDirtyFlagTriggered() override;
     void onDirtyCachedInheritableStylesTriggered() override;
+    void onPaintDirtyFlagTriggered() override;
     void onPreferredThemeChanged(ui::style::Theme theme) override;
 
   public:
@@ -29,6 +42,24 @@ class Root : public Element {
     // check for styles and layout update
     void update();
 
+    // Something changed in the tree since it was last painted
+    bool needsRepaint() const;
+
+    // Unconditional layout pass, layout boundaries included
+    void calculateLayout();
+
+    // Unconditional inheritable styles propagation pass
+    void propagateStyles();
+
+    // Marks inherited styles of every element as dirty without resolving them,
+    // unlike style updates which make root resolve right away (e.g. to time `propagateStyles`)
+    void invalidateStyles();
+
+    // Threads resolving inherited styles and laying out layout boundaries, calling thread included.
+    // Results are the same as on a single thread
+    void setThreadCount(std::size_t threadCount);
+    std::size_t getThreadCount() const;
+
     void render(const Vector2&) override;
 
     void onWindowResized(int newScreenWidth, int newScreenHeight);
@@ -1,5 +1,6 @@
 #include "./Text.h"
 #include "../../core/repository/FontRepository.h"
+#include "../rendering/backend/DrawBackend.h"
 
 #include <raylib.h>
 #include <yoga/YGNodeLayout.h>
@@ -12,14 +13,8 @@ Text::Text(const std::string &text) : Element("Text"), _text(text) {}
 void Text::setText(const std::string &text) {
     _text = text;
     const auto fontSize = _cachedInheritableProps.fontSize.unwrap();
-    Vector2 textSize;
-
-    if (auto font = getUsedFont())
-        textSize = MeasureTextEx(*font, text.c_str(), fontSize, _cachedInheritableProps.letterSpacing.unwrap());
-    else {
-        textSize.x = MeasureText(text.c_str(), fontSize);
-        textSize.y = fontSize;
-    }
+    const auto font = getUsedFont();
+    const auto textSize = ui::rendering::backend::DrawBackend::Get().measureText(font.get(), text.c_str(), fontSize, _cachedInheritableProps.letterSpacing.unwrap());
 
     auto layout = getLayout();
     {
@@ -28,6 +23,7 @@ void Text::setText(const std::string &text) {
         size.height = utils::Value<int>(textSize.y);
     }
     updateLayout(layout);
+    markPaintAsDirty(); // same size, other glyphs
 }
 
 void Text::render(const Vector2& offset) {
@@ -44,13 +40,11 @@ void Text::render(const Vector2& offset) {
     const auto fontSize = _cachedInheritableProps.fontSize.unwrap();
     const auto color = _cachedInheritableProps.color.unwrap();
 
-    if (auto font = getUsedFont())
-        DrawTextEx(*font, _text.c_str(), {bb.x, bb.y}, fontSize, _cachedInheritableProps.letterSpacing.unwrap(), color);
-    else
-        DrawText(_text.c_str(), bb.x, bb.y, fontSize, color);
+    const auto font = getUsedFont();
+    ui::rendering::backend::DrawBackend::Get().drawText(font.get(), _text.c_str(), {bb.x, bb.y}, fontSize, _cachedInheritableProps.letterSpacing.unwrap(), color);
 }
 
-std::optional<Font> Text::getUsedFont() const {
+std::shared_ptr<const Font> Text::getUsedFont() const {
     auto fonts = repository::FontRepository::Get();
     if (!fonts) {
         const std::string errorMessage("[Text] Font repository not initialized.");
@@ -58,17 +52,19 @@ std::optional<Font> Text::getUsedFont() const {
         throw std::logic_error(errorMessage);
     }
 
-    const auto fontFamily = _cachedInheritableProps.fontFamily.unwrap();
-    std::optional<Font> font;
-
-    for (const auto &fontName : fontFamily) {
-        if (auto registeredFont = fonts->get(fontName)) {
-            font = registeredFont;
-            break;
-        }
+    const auto version = fonts->getVersion();
+    if (_fontVersion != version) {
+        _font = fonts->resolve(_cachedInheritableProps.fontFamily.unwrap());
+        // family may still change while styles are not propagated, without notifying again
+        if (!_dirtyCachedInheritableProps)
+            _fontVersion = version;
     }
 
-    return font;
+    return fonts->get(_font);
+}
+
+void Text::onDirtyCachedInheritableStylesTriggered() {
+    _fontVersion.reset();
 }
 
 void Text::onChildAppended(std::shared_ptr<Element>) {
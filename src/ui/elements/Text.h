@@ -1,10 +1,12 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
 #include <optional>
 
 #include <raylib.h>
 
+#include "../../core/repository/Handle.h"
 #include "./Element.h"
 
 namespace ui {
@@ -13,9 +15,14 @@ namespace element {
 class Text : public Element {
   std::string _text;
 
-  std::optional<Font> getUsedFont() const;
+  // first loaded font of font family, resolved again once family or fonts change
+  mutable repository::FontHandle _font;
+  mutable std::optional<std::uint64_t> _fontVersion; // font repository version `_font` was resolved at
+
+  std::shared_ptr<const Font> getUsedFont() const;
 
   void onChildAppended(std::shared_ptr<Element>) override;
+  void onDirtyCachedInheritableStylesTriggered() override;
 
  public:
   Text(const std::string& text);
@@ -0,0 +1,155 @@
+#include "./TextDocument.h"
+#include "../../core/repository/FontRepository.h"
+#include "../rendering/backend/DrawBackend.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ui {
+namespace element {
+
+TextDocument::TextDocument(std::string_view text)
+    : Element("TextDocument"), _document(text), _firstVisibleLine(0), _followTail(false) {}
+
+void TextDocument::setText(std::string_view text) {
+    _document.assign(text);
+    _firstVisibleLine = std::min(_firstVisibleLine, _document.lineCount() - 1);
+    markPaintAsDirty();
+}
+
+void TextDocument::append(std::string_view text) {
+    _document.append(text);
+    markPaintAsDirty();
+}
+
+void TextDocument::insert(std::size_t pos, std::string_view text) {
+    _document.insert(pos, text);
+    markPaintAsDirty();
+}
+
+void TextDocument::erase(std::size_t pos, std::size_t count) {
+    _document.erase(pos, count);
+    _firstVisibleLine = std::min(_firstVisibleLine, _document.lineCount() - 1);
+    markPaintAsDirty();
+}
+
+void TextDocument::clear() {
+    _document.clear();
+    _firstVisibleLine = 0;
+    markPaintAsDirty();
+}
+
+const ui::text::Rope &TextDocument::getDocument() const {
+    return _document;
+}
+
+std::size_t TextDocument::getLineCount() const {
+    return _document.lineCount();
+}
+
+void TextDocument::scrollToLine(std::size_t line) {
+    _followTail = false;
+    _firstVisibleLine = std::min(line, _document.lineCount() - 1);
+    markPaintAsDirty();
+}
+
+std::size_t TextDocument::getFirstVisibleLine() const {
+    if (!_followTail)
+        return _firstVisibleLine;
+
+    const auto lineCount = _document.lineCount();
+    const auto visibleLines = getVisibleLineCount();
+    return lineCount > visibleLines ? lineCount - visibleLines : 0;
+}
+
+std::size_t TextDocument::getVisibleLineCount() const {
+    const auto lineHeight = getLineHeight();
+    if (lineHeight <= 0)
+        return 0;
+
+    return std::ceil(getBoundingRect().height / lineHeight);
+}
+
+void TextDocument::setFollowTail(bool followTail) {
+    _followTail = followTail;
+    markPaintAsDirty();
+}
+
+bool TextDocument::isFollowingTail() const {
+    return _followTail;
+}
+
+float TextDocument::getLineHeight() const {
+    return _cachedInheritableProps.fontSize.unwrap();
+}
+
+void TextDocument::render(const Vector2 &offset) {
+    Element::render(offset);
+
+    auto bb = getBoundingRect();
+    bb.x += offset.x;
+    bb.y += offset.y;
+
+    const auto lineHeight = getLineHeight();
+    const auto firstLine = getFirstVisibleLine();
+    const auto lastLine = std::min(firstLine + getVisibleLineCount(), _document.lineCount());
+    if (firstLine >= lastLine)
+        return;
+
+    // fetch visible range at once instead of looking up every single line
+    const auto start = _document.lineStart(firstLine);
+    const auto visibleText = _document.substr(start, _document.lineStart(lastLine) - start);
+
+    const auto fontSize = _cachedInheritableProps.fontSize.unwrap();
+    const auto color = _cachedInheritableProps.color.unwrap();
+    const auto letterSpacing = _cachedInheritableProps.letterSpacing.unwrap();
+    const auto font = getUsedFont();
+    auto &backend = ui::rendering::backend::DrawBackend::Get();
+
+    std::string line;
+    std::size_t lineBegin = 0;
+    for (auto index = firstLine; index < lastLine; ++index) {
+        auto lineEnd = visibleText.find('\n', lineBegin);
+        if (lineEnd == std::string::npos)
+            lineEnd = visibleText.size();
+
+        line.assign(visibleText, lineBegin, lineEnd - lineBegin);
+        const Vector2 position{bb.x, bb.y + (index - firstLine) * lineHeight};
+
+        backend.drawText(font.get(), line.c_str(), position, fontSize, letterSpacing, color);
+
+        lineBegin = lineEnd + 1;
+    }
+}
+
+std::shared_ptr<const Font> TextDocument::getUsedFont() const {
+    auto fonts = repository::FontRepository::Get();
+    if (!fonts) {
+        const std::string errorMessage("[TextDocument] Font repository not initialized.");
+        TraceLog(LOG_FATAL, errorMessage.c_str());
+        throw std::logic_error(errorMessage);
+    }
+
+    const auto version = fonts->getVersion();
+    if (_fontVersion != version) {
+        _font = fonts->resolve(_cachedInheritableProps.fontFamily.unwrap());
+        // family may still change while styles are not propagated, without notifying again
+        if (!_dirtyCachedInheritableProps)
+            _fontVersion = version;
+    }
+
+    return fonts->get(_font);
+}
+
+void TextDocument::onDirtyCachedInheritableStylesTriggered() {
+    _fontVersion.reset();
+}
+
+void TextDocument::onChildAppended(std::shared_ptr<Element>) {
+    const std::string errorMessage("[TextDocument] TextDocument element can only be used as leaf node.");
+    TraceLog(LOG_FATAL, errorMessage.c_str());
+    throw std::logic_error(errorMessage);
+}
+
+} // namespace element
+} // namespace ui
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <raylib.h>
+
+#include "../text/Rope.h"
+#include "../../core/repository/Handle.h"
+#include "./Element.h"
+
+namespace ui {
+namespace element {
+
+/**
+ * Multi-line text viewport meant for large documents (logs, files, ...).
+ * Unlike `Text`, this element does not size itself after its content :
+ * its size has to be provided through layout and only lines inside its bounding box are drawn.
+ * Editing the document never triggers a layout update.
+ */
+class TextDocument : public Element {
+    ui::text::Rope _document;
+    std::size_t _firstVisibleLine;
+    bool _followTail; // keep last lines in view while content is appended
+
+    // first loaded font of font family, resolved again once family or fonts change
+    mutable repository::FontHandle _font;
+    mutable std::optional<std::uint64_t> _fontVersion; // font repository version `_font` was resolved at
+
+    std::shared_ptr<const Font> getUsedFont() const;
+    float getLineHeight() const;
+
+    void onChildAppended(std::shared_ptr<Element>) override;
+    void onDirtyCachedInheritableStylesTriggered() override;
+
+  public:
+    TextDocument(std::string_view text = "");
+
+    void setText(std::string_view text);
+    void append(std::string_view text);
+    void insert(std::size_t pos, std::string_view text);
+    void erase(std::size_t pos, std::size_t count);
+    void clear();
+
+    const ui::text::Rope &getDocument() const;
+    std::size_t getLineCount() const;
+
+    // Disables tail following
+    void scrollToLine(std::size_t line);
+    std::size_t getFirstVisibleLine() const;
+    std::size_t getVisibleLineCount() const;
+
+    void setFollowTail(bool followTail);
+    bool isFollowingTail() const;
+
+    void render(const Vector2 &) override;
+};
+
+} // namespace element
+} // namespace ui
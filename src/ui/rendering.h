@@ -1,4 +1,17 @@
 #pragma once
 
+#include "./rendering/DebugOverlay.h"
 #include "./rendering/Layer.h"
-#include "./rendering/StackingContext.h"
\ No newline at end of file
+#include "./rendering/RenderStats.h"
+#include "./rendering/RenderTargetPool.h"
+#include "./rendering/StackingContext.h"
+#include "./rendering/backend/CommandList.h"
+#include "./rendering/backend/Compositor.h"
+#include "./rendering/backend/DrawBackend.h"
+#include "./rendering/backend/NullBackend.h"
+#include "./rendering/backend/RaylibBackend.h"
+#include "./rendering/backend/RecordingBackend.h"
+#include "./rendering/backend/SoftwareBackend.h"
+#include "./rendering/backend/SpanKernels.h"
+#include "./rendering/backend/Surface.h"
+#include "./rendering/backend/ThreadedBackend.h"
\ No newline at end of file
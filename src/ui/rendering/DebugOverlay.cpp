@@ -0,0 +1,174 @@
+#include "./DebugOverlay.h"
+#include "../elements/Element.h"
+#include "./Layer.h"
+#include "./StackingContext.h"
+#include "./backend/DrawBackend.h"
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <stack>
+
+namespace ui {
+namespace rendering {
+
+namespace {
+constexpr int LabelFontSize = 10;
+constexpr Color LayerOutlineColor = {0, 228, 48, 255};
+constexpr Color StackingContextOutlineColor = {255, 161, 0, 255};
+} // namespace
+
+DebugOverlay::DebugOverlay() : _enabled(false), _columns(0), _rows(0) {}
+
+DebugOverlay &DebugOverlay::Get() {
+    static DebugOverlay overlay;
+    return overlay;
+}
+
+Rectangle DebugOverlay::GetScreenRect(std::shared_ptr<const ui::element::Element> element) {
+    auto rect = element->getBoundingRect();
+    for (auto parent = element->getParent(); parent; parent = parent->getParent()) {
+        const auto parentRect = parent->getBoundingRect();
+        rect.x += parentRect.x;
+        rect.y += parentRect.y;
+    }
+    return rect;
+}
+
+bool DebugOverlay::isEnabled() const {
+    return _enabled;
+}
+
+void DebugOverlay::setEnabled(bool enabled) {
+    if (enabled && !_enabled)
+        std::fill(_repaints.begin(), _repaints.end(), 0);
+    _enabled = enabled;
+}
+
+void DebugOverlay::toggle() {
+    setEnabled(!_enabled);
+}
+
+void DebugOverlay::resize(int screenWidth, int screenHeight) {
+    _columns = (screenWidth + CellSize - 1) / CellSize;
+    _rows = (screenHeight + CellSize - 1) / CellSize;
+    _repaints.assign(_columns * _rows, 0);
+}
+
+void DebugOverlay::beginFrame(int screenWidth, int screenHeight) {
+    if (!_enabled)
+        return;
+
+    if (_columns != (screenWidth + CellSize - 1) / CellSize || _rows != (screenHeight + CellSize - 1) / CellSize)
+        resize(screenWidth, screenHeight);
+
+    for (auto &cell : _repaints)
+        cell <<= 1;
+}
+
+void DebugOverlay::recordRepaint(const Rectangle &screenRect) {
+    if (!_enabled || screenRect.width <= 0 || screenRect.height <= 0)
+        return;
+
+    const int left = std::clamp(int(screenRect.x) / CellSize, 0, _columns);
+    const int top = std::clamp(int(screenRect.y) / CellSize, 0, _rows);
+    const int right = std::clamp(int(screenRect.x + screenRect.width + CellSize - 1) / CellSize, 0, _columns);
+    const int bottom = std::clamp(int(screenRect.y + screenRect.height + CellSize - 1) / CellSize, 0, _rows);
+
+    for (int row = top; row < bottom; ++row)
+        for (int column = left; column < right; ++column)
+            _repaints[row * _columns + column] |= 1;
+}
+
+void DebugOverlay::recordRepaint(std::shared_ptr<const ui::element::Element> element) {
+    if (_enabled && element)
+        recordRepaint(GetScreenRect(element));
+}
+
+int DebugOverlay::getRepaintCount(const Vector2 &point) const {
+    const int column = point.x / CellSize;
+    const int row = point.y / CellSize;
+    if (column < 0 || row < 0 || column >= _columns || row >= _rows)
+        return 0;
+
+    return std::popcount(_repaints[row * _columns + column]);
+}
+
+void DebugOverlay::draw(std::shared_ptr<StackingContext> rootCtx, std::shared_ptr<Layer> rootLayer) const {
+    if (!_enabled)
+        return;
+
+    drawHeatMap();
+    drawStackingContextOutlines(rootCtx);
+    drawLayerOutlines(rootLayer);
+}
+
+void DebugOverlay::drawHeatMap() const {
+    for (int row = 0; row < _rows; ++row) {
+        for (int column = 0; column < _columns; ++column) {
+            const auto count = std::popcount(_repaints[row * _columns + column]);
+            if (count == 0)
+                continue;
+
+            // blue when rarely repainted, red when repainted every frame
+            const float heat = float(count) / FrameWindow;
+            const Color tint{
+                .r = (unsigned char)(255 * heat),
+                .g = 0,
+                .b = (unsigned char)(255 * (1.0f - heat)),
+                .a = (unsigned char)(48 + 96 * heat)};
+            backend::DrawBackend::Get().drawRectangle(Rectangle{float(column * CellSize), float(row * CellSize), CellSize, CellSize}, tint);
+        }
+    }
+}
+
+void DebugOverlay::drawLayerOutlines(std::shared_ptr<Layer> rootLayer) const {
+    if (!rootLayer)
+        return;
+
+    std::stack<std::pair<std::shared_ptr<Layer>, Vector2>> stack;
+    stack.push({rootLayer, Vector2{0.0, 0.0}});
+
+    while (!stack.empty()) {
+        auto [layer, parentOrigin] = stack.top();
+        stack.pop();
+
+        auto rect = layer->getLastDestination();
+        rect.x += parentOrigin.x;
+        rect.y += parentOrigin.y;
+
+        const auto size = layer->getTextureSize();
+        auto &backend = backend::DrawBackend::Get();
+        backend.drawRectangleLines(rect, 2.0, LayerOutlineColor);
+        backend.drawText(nullptr, std::format("L{} {}x{}", layer->getId(), int(size.x), int(size.y)).c_str(), Vector2{rect.x + 4, rect.y + 4}, LabelFontSize, 0.0, LayerOutlineColor);
+
+        for (auto child : layer->getChildren())
+            stack.push({child, Vector2{rect.x, rect.y}});
+    }
+}
+
+void DebugOverlay::drawStackingContextOutlines(std::shared_ptr<StackingContext> rootCtx) const {
+    if (!rootCtx)
+        return;
+
+    std::stack<std::shared_ptr<StackingContext>> stack;
+    stack.push(rootCtx);
+
+    while (!stack.empty()) {
+        auto ctx = stack.top();
+        stack.pop();
+
+        if (auto owner = ctx->getOwner()) {
+            const auto rect = GetScreenRect(owner);
+            auto &backend = backend::DrawBackend::Get();
+            backend.drawRectangleLines(rect, 1.0, StackingContextOutlineColor);
+            backend.drawText(nullptr, std::format("S{}", ctx->getId()).c_str(), Vector2{rect.x + 4, rect.y + rect.height - LabelFontSize - 4}, LabelFontSize, 0.0, StackingContextOutlineColor);
+        }
+
+        for (auto child : ctx->getChildren())
+            stack.push(child);
+    }
+}
+
+} // namespace rendering
+} // namespace ui
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ui {
+
+namespace element {
+class Element; // forward declaration
+}
+
+namespace rendering {
+
+class Layer;           // forward declaration
+class StackingContext; // forward declaration
+
+/**
+ * Debug pass drawn over the composited frame :
+ * - repaint heat-map : screen is split in cells, each cell keeps one bit per frame
+ *   telling whether something was painted over it during the last `FrameWindow` frames
+ * - layer outlines with id and texture size
+ * - stacking context owner outlines with id
+ * Layer outlines ignore rotation.
+ */
+class DebugOverlay {
+  public:
+    static constexpr int CellSize = 16;
+    static constexpr int FrameWindow = 64;
+
+  private:
+    bool _enabled;
+    int _columns;
+    int _rows;
+    std::vector<std::uint64_t> _repaints; // row-major, bit 0 is current frame
+
+    DebugOverlay();
+
+    void resize(int screenWidth, int screenHeight);
+    void drawHeatMap() const;
+    void drawLayerOutlines(std::shared_ptr<Layer> rootLayer) const;
+    void drawStackingContextOutlines(std::shared_ptr<StackingContext> rootCtx) const;
+
+  public:
+    static DebugOverlay &Get();
+
+    // Absolute bounding rect, transforms are not taken in account
+    static Rectangle GetScreenRect(std::shared_ptr<const ui::element::Element> element);
+
+    bool isEnabled() const;
+    void setEnabled(bool enabled);
+    void toggle();
+
+    // Must be called before painting the frame
+    void beginFrame(int screenWidth, int screenHeight);
+
+    void recordRepaint(const Rectangle &screenRect);
+    void recordRepaint(std::shared_ptr<const ui::element::Element> element);
+
+    // Number of frames, among last `FrameWindow`, cell containing `point` has been repainted
+    int getRepaintCount(const Vector2 &point) const;
+
+    // Final pass, must be called after compositing
+    void draw(std::shared_ptr<StackingContext> rootCtx, std::shared_ptr<Layer> rootLayer) const;
+};
+
+} // namespace rendering
+} // namespace ui
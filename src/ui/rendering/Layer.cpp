@@ -4,11 +4,15 @@
 #include <queue>
 #include <stack>
 
+#include "../../core/profiling/Tracer.h"
 #include "../elements/Element.h"
 #include "../styles/Style.h"
+#include "./RenderStats.h"
+#include "./RenderTargetPool.h"
 #include "./StackingContext.h"
 
 ui::rendering::Layer::LayerId ui::rendering::Layer::nextId = 0;
+std::optional<std::pair<int, int>> ui::rendering::Layer::sizeCap;
 
 namespace ui {
 namespace rendering {
@@ -21,21 +25,27 @@ Layer::Context::Context(const ui::style::Style &style) {
 
 Layer::Layer(std::shared_ptr<ui::element::Element> owner)
     : _owner(owner) {
+    TRACE_ZONE("LayerAllocation");
     _id = nextId++;
-    _cleanRenderTexture = true;
+    // may be recycled from a previous layer, cleared before first paint
+    _cleanRenderTexture = false;
 
     const auto rect = getElementsBoundingRect();
-    _renderTexture = LoadRenderTexture(std::min(GetScreenWidth(), (int)rect.width), std::min(GetScreenHeight(), (int)rect.height));
+    auto &backend = backend::DrawBackend::Get();
+    const auto [maxWidth, maxHeight] = sizeCap.value_or(std::make_pair(backend.getScreenWidth(), backend.getScreenHeight()));
+    _renderTexture = RenderTargetPool::Get().acquire(std::min(maxWidth, (int)rect.width), std::min(maxHeight, (int)rect.height));
 
     if (_renderTexture.id == 0) {
         const std::string errorMessage("[Layer] Unable to create render texture.");
         TraceLog(LOG_FATAL, errorMessage.c_str());
         throw std::runtime_error(errorMessage);
     }
+
+    _lastDestination = Rectangle{0, 0, (float)_renderTexture.texture.width, (float)_renderTexture.texture.height};
 }
 
 Layer::~Layer() {
-    UnloadRenderTexture(_renderTexture);
+    RenderTargetPool::Get().release(_renderTexture);
 }
 
 Rectangle Layer::getElementsBoundingRect() const {
@@ -157,19 +167,21 @@ void Layer::render() {
 
     dest.x += origin.x;
     dest.y += origin.y;
-
-    DrawTexturePro(_renderTexture.texture,
-                   Rectangle{
-                       .x = 0,
-                       .y = 0,
-                       .width = (float)_renderTexture.texture.width,
-                       .height = -(float)_renderTexture.texture.height},
-                   dest, origin, rotation,
-                   Color{
-                       .r = 255,
-                       .g = 255,
-                       .b = 255,
-                       .a = (unsigned char)alpha});
+    _lastDestination = Rectangle{dest.x - origin.x, dest.y - origin.y, dest.width, dest.height};
+
+    backend::DrawBackend::Get().drawTexture(_renderTexture.texture,
+                                            Rectangle{
+                                                .x = 0,
+                                                .y = 0,
+                                                .width = (float)_renderTexture.texture.width,
+                                                .height = -(float)_renderTexture.texture.height},
+                                            dest, origin, rotation,
+                                            Color{
+                                                .r = 255,
+                                                .g = 255,
+                                                .b = 255,
+                                                .a = (unsigned char)alpha});
+    RenderStats::Get().countLayer(_renderTexture, dest);
 
     _cleanRenderTexture = false;
 }
@@ -190,6 +202,14 @@ Layer::LayerId Layer::getId() const {
     return _id;
 }
 
+Vector2 Layer::getTextureSize() const {
+    return Vector2{(float)_renderTexture.texture.width, (float)_renderTexture.texture.height};
+}
+
+Rectangle Layer::getLastDestination() const {
+    return _lastDestination;
+}
+
 std::vector<std::shared_ptr<Layer>> Layer::getChildren() const {
     return _children;
 }
@@ -249,9 +269,10 @@ bool Layer::isClean() const {
 }
 
 void Layer::clearRenderTarget() {
-    BeginTextureMode(_renderTexture);
-    ClearBackground(BLANK);
-    EndTextureMode();
+    auto &backend = backend::DrawBackend::Get();
+    backend.beginRenderTarget(_renderTexture);
+    backend.clear(BLANK);
+    backend.endRenderTarget();
 
     _cleanRenderTexture = true;
 }
@@ -274,6 +295,10 @@ bool Layer::IsRequiredFor(std::shared_ptr<const ui::element::Element> element) {
     */
 }
 
+void Layer::SetSizeCap(std::optional<std::pair<int, int>> size) {
+    sizeCap = size;
+}
+
 std::shared_ptr<Layer> Layer::BuildTree(std::shared_ptr<StackingContext> rootCtx) {
     // [currentCtx, parentLayer]
     std::queue<std::pair<std::shared_ptr<ui::rendering::StackingContext>, std::shared_ptr<ui::rendering::Layer>>> queue;
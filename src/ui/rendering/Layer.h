@@ -5,9 +5,11 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "../styles/Transform.h"
+#include "./backend/DrawBackend.h"
 
 namespace ui {
 
@@ -32,10 +34,10 @@ class Layer : public std::enable_shared_from_this<Layer> {
 
       public:
         UseLayerGuard() = default;
-        UseLayerGuard(RenderTexture2D texture) : _texture(texture) { BeginTextureMode(texture); }
+        UseLayerGuard(RenderTexture2D texture) : _texture(texture) { backend::DrawBackend::Get().beginRenderTarget(texture); }
         ~UseLayerGuard() {
             if (_texture)
-                EndTextureMode();
+                backend::DrawBackend::Get().endRenderTarget();
         }
     };
 
@@ -52,11 +54,13 @@ class Layer : public std::enable_shared_from_this<Layer> {
 
   private:
     static LayerId nextId;
+    static std::optional<std::pair<int, int>> sizeCap; // screen size if unset
 
     LayerId _id;
     std::vector<std::shared_ptr<Layer>> _children;
     std::weak_ptr<Layer> _parent;
     RenderTexture2D _renderTexture;
+    Rectangle _lastDestination; // where texture has been drawn in parent layer
     bool _cleanRenderTexture;
     std::weak_ptr<ui::element::Element> _owner;
 
@@ -79,6 +83,11 @@ class Layer : public std::enable_shared_from_this<Layer> {
     std::shared_ptr<ui::element::Element> getOwner() const;
 
     LayerId getId() const;
+    Vector2 getTextureSize() const;
+
+    // Unrotated area covered in parent layer during last render
+    Rectangle getLastDestination() const;
+
     Context getContext() const;
     std::vector<std::shared_ptr<Layer>> getChildren() const;
 
@@ -107,6 +116,10 @@ class Layer : public std::enable_shared_from_this<Layer> {
     static bool IsRequiredFor(std::shared_ptr<const ui::element::Element> element);
 
     static std::shared_ptr<Layer> BuildTree(std::shared_ptr<StackingContext> ctx);
+
+    // Render textures of layers created from now on are capped to `width` x `height` instead of screen size,
+    // e.g. while laid out for an offscreen target. `std::nullopt` restores screen size
+    static void SetSizeCap(std::optional<std::pair<int, int>> size);
 };
 
 } // namespace rendering
@@ -0,0 +1,111 @@
+#include "./RenderStats.h"
+#include "../../core/repository/TextureRepository.h"
+
+#include <cctype>
+#include <format>
+
+namespace ui {
+namespace rendering {
+
+RenderStats::RenderStats() : _current{}, _lastFrame{}, _logEverySecond(false), _lastLog(0.0) {}
+
+RenderStats &RenderStats::Get() {
+    static RenderStats stats;
+    return stats;
+}
+
+std::uint32_t RenderStats::RoundedRectangleVertices(int segments) {
+    // four corner fans plus center and side quads
+    return 4 * segments * 4 + 5 * 4;
+}
+
+void RenderStats::countPaintedElement(const Rectangle &boundingRect) {
+    _current.elementsPainted++;
+    _current.paintedArea += boundingRect.width * boundingRect.height;
+}
+
+void RenderStats::countSkippedElement() {
+    _current.elementsSkipped++;
+}
+
+void RenderStats::countLayer(const RenderTexture2D &target, const Rectangle &dest) {
+    _current.layers++;
+    _current.layerTextureBytes += std::uint64_t(target.texture.width) * target.texture.height * 4;
+    _current.paintedArea += dest.width * dest.height;
+}
+
+void RenderStats::countRenderTargetSwitch() {
+    _current.renderTargetSwitches++;
+}
+
+void RenderStats::countDrawCall(std::uint32_t vertices) {
+    _current.drawCalls++;
+    _current.vertices += vertices;
+}
+
+void RenderStats::countTextDrawCall(const char *text) {
+    // one quad per visible glyph
+    std::uint32_t glyphs = 0;
+    for (auto c = text; *c; ++c)
+        if (!std::isspace(static_cast<unsigned char>(*c)) && (*c & 0xC0) != 0x80)
+            glyphs++;
+
+    countDrawCall(glyphs * 4);
+}
+
+void RenderStats::countScissorChange() {
+    _current.scissorChanges++;
+}
+
+void RenderStats::endFrame(int screenWidth, int screenHeight) {
+    const double screenArea = double(screenWidth) * screenHeight;
+    _current.overdraw = screenArea > 0 ? _current.paintedArea / screenArea : 0.0;
+
+    _lastFrame = _current;
+    _current = Counters{};
+    _current.frame = _lastFrame.frame + 1;
+
+    if (_logEverySecond) {
+        const auto now = GetTime();
+        if (now - _lastLog >= 1.0) {
+            TraceLog(LOG_INFO, "[RenderStats] %s", report().c_str());
+            _lastLog = now;
+        }
+    }
+}
+
+const RenderStats::Counters &RenderStats::getLastFrame() const {
+    return _lastFrame;
+}
+
+const RenderStats::Counters &RenderStats::getCurrent() const {
+    return _current;
+}
+
+void RenderStats::setLogEverySecond(bool log) {
+    _logEverySecond = log;
+}
+
+bool RenderStats::isLoggingEverySecond() const {
+    return _logEverySecond;
+}
+
+std::string RenderStats::textureReport() const {
+    if (!repository::TextureRepository::Exists())
+        return "";
+
+    const auto textures = repository::TextureRepository::Get()->getStats();
+    return std::format(", textures {} KiB resident ({} KiB budget), {} evictions, {} reloads",
+                       textures.residentBytes / 1024, textures.budget / 1024, textures.evictions, textures.reloads);
+}
+
+std::string RenderStats::report() const {
+    const auto &s = _lastFrame;
+    return std::format("frame {} : {} painted, {} skipped, {} layers ({} KiB), {} target switches, {} draw calls, {} vertices, {} scissor changes, overdraw {:.2f}",
+                       s.frame, s.elementsPainted, s.elementsSkipped, s.layers, s.layerTextureBytes / 1024,
+                       s.renderTargetSwitches, s.drawCalls, s.vertices, s.scissorChanges, s.overdraw) +
+           textureReport();
+}
+
+} // namespace rendering
+} // namespace ui
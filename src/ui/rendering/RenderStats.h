@@ -0,0 +1,71 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <cstdint>
+#include <string>
+
+namespace ui {
+namespace rendering {
+
+/**
+ * Per-frame rendering counters, fed by elements, layers and scissor stack while painting.
+ * Draw calls are counted per raylib draw function call (before rlgl batching)
+ * and vertices are estimated from the shape being drawn.
+ * Only meant to be used from the thread owning the graphics context.
+ */
+class RenderStats {
+  public:
+    struct Counters {
+        std::uint64_t frame;
+        std::uint32_t elementsPainted;
+        std::uint32_t elementsSkipped; // not displayed
+        std::uint32_t layers;          // composited layers
+        std::uint64_t layerTextureBytes;
+        std::uint32_t renderTargetSwitches; // BeginTextureMode calls
+        std::uint32_t drawCalls;
+        std::uint64_t vertices;
+        std::uint32_t scissorChanges;
+        double paintedArea; // in pixels, accumulated over painted elements and layer blits
+        float overdraw;     // painted area / screen area
+    };
+
+  private:
+    Counters _current;
+    Counters _lastFrame;
+    bool _logEverySecond;
+    double _lastLog;
+
+    RenderStats();
+
+    // Texture residency, from texture repository
+    std::string textureReport() const;
+
+  public:
+    static RenderStats &Get();
+
+    // Vertices submitted by raylib for a rounded rectangle (fill or lines)
+    static std::uint32_t RoundedRectangleVertices(int segments);
+
+    void countPaintedElement(const Rectangle &boundingRect);
+    void countSkippedElement();
+    void countLayer(const RenderTexture2D &target, const Rectangle &dest);
+    void countRenderTargetSwitch();
+    void countDrawCall(std::uint32_t vertices);
+    void countTextDrawCall(const char *text);
+    void countScissorChange();
+
+    // Closes current frame, counters become available through `getLastFrame`
+    void endFrame(int screenWidth, int screenHeight);
+
+    const Counters &getLastFrame() const;
+    const Counters &getCurrent() const;
+
+    void setLogEverySecond(bool log);
+    bool isLoggingEverySecond() const;
+
+    std::string report() const;
+};
+
+} // namespace rendering
+} // namespace ui
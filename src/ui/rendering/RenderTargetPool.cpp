@@ -0,0 +1,76 @@
+#include "./RenderTargetPool.h"
+#include "./backend/DrawBackend.h"
+
+namespace ui {
+namespace rendering {
+
+namespace {
+
+std::uint64_t bytesOf(const RenderTexture2D &target) {
+    return std::uint64_t(target.texture.width) * target.texture.height * 4;
+}
+
+} // namespace
+
+RenderTargetPool::RenderTargetPool() : _freeBytes(0), _budget(256 * 1024 * 1024) {}
+
+RenderTargetPool &RenderTargetPool::Get() {
+    static RenderTargetPool pool;
+    return pool;
+}
+
+RenderTexture2D RenderTargetPool::acquire(int width, int height) {
+    auto it = _free.find({width, height});
+    if (it == _free.end() || it->second.empty())
+        return backend::DrawBackend::Get().loadRenderTarget(width, height);
+
+    const auto target = it->second.back();
+    it->second.pop_back();
+    _freeBytes -= bytesOf(target);
+    return target;
+}
+
+void RenderTargetPool::release(const RenderTexture2D &target) {
+    if (target.id == 0)
+        return;
+
+    _free[{target.texture.width, target.texture.height}].push_back(target);
+    _freeBytes += bytesOf(target);
+    trim();
+}
+
+void RenderTargetPool::setBudget(std::uint64_t bytes) {
+    _budget = bytes;
+    trim();
+}
+
+std::uint64_t RenderTargetPool::getFreeBytes() const {
+    return _freeBytes;
+}
+
+void RenderTargetPool::trim() {
+    // widest targets go first, they are the least likely to be requested again
+    while (_freeBytes > _budget && !_free.empty()) {
+        auto last = std::prev(_free.end());
+        if (last->second.empty()) {
+            _free.erase(last);
+            continue;
+        }
+
+        _freeBytes -= bytesOf(last->second.back());
+        backend::DrawBackend::Get().unloadRenderTarget(last->second.back());
+        last->second.pop_back();
+    }
+}
+
+void RenderTargetPool::clear() {
+    for (auto &[size, targets] : _free)
+        for (const auto &target : targets)
+            backend::DrawBackend::Get().unloadRenderTarget(target);
+
+    _free.clear();
+    _freeBytes = 0;
+}
+
+} // namespace rendering
+} // namespace ui
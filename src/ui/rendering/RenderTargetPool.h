@@ -0,0 +1,44 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace ui {
+namespace rendering {
+
+/**
+ * Keeps released render targets around so that layers rebuilt at the same size
+ * (style changes, batch snapshots) do not reallocate GPU memory.
+ * Recycled targets keep their previous content, callers must clear them before use.
+ * Must be emptied before the draw backend changes or the window closes.
+ */
+class RenderTargetPool {
+    std::map<std::pair<int, int>, std::vector<RenderTexture2D>> _free; // by size
+    std::uint64_t _freeBytes;
+    std::uint64_t _budget;
+
+    RenderTargetPool();
+
+    void trim();
+
+  public:
+    static RenderTargetPool &Get();
+
+    // Recycled target of this size if any, freshly loaded one otherwise (`id` 0 on failure)
+    RenderTexture2D acquire(int width, int height);
+    void release(const RenderTexture2D &target);
+
+    // Bytes of free targets kept, widest ones are unloaded first when exceeded
+    void setBudget(std::uint64_t bytes);
+    std::uint64_t getFreeBytes() const;
+
+    // Unloads every free target
+    void clear();
+};
+
+} // namespace rendering
+} // namespace ui
@@ -1,4 +1,5 @@
 #include "./ScissorStack.h"
+#include "./backend/DrawBackend.h"
 
 namespace ui {
 namespace rendering {
@@ -18,7 +19,7 @@ void ScissorStack::push(const Rectangle &rect) {
         _stack.push(GetCollisionRec(_stack.top(), rect));
 
     const auto latest = _stack.top();
-    BeginScissorMode(latest.x, latest.y, latest.width, latest.height);
+    backend::DrawBackend::Get().beginScissor(latest);
 }
 
 Rectangle ScissorStack::pop() {
@@ -26,11 +27,9 @@ Rectangle ScissorStack::pop() {
     _stack.pop();
 
     if (_stack.empty())
-        EndScissorMode();
-    else {
-        const auto latest = _stack.top();
-        BeginScissorMode(latest.x, latest.y, latest.width, latest.height);
-    }
+        backend::DrawBackend::Get().endScissor();
+    else
+        backend::DrawBackend::Get().beginScissor(_stack.top());
 
     return rect;
 }
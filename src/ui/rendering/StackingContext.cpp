@@ -1,6 +1,9 @@
 #include "./StackingContext.h"
+#include "../../core/profiling/Profiler.h"
 #include "../elements/Element.h"
+#include "./DebugOverlay.h"
 #include "./Layer.h"
+#include "./RenderStats.h"
 
 #include <algorithm>
 #include <format>
@@ -157,7 +160,9 @@ Vector2 StackingContext::render(ScissorStack& scissorStack, const Vector2& paren
     // TODO : we may want to update layer's position (cache)
 
     auto useLayerGuard = layer->use();
-    if (!owner->isNotDisplayed()) {
+    if (owner->isNotDisplayed())
+        RenderStats::Get().countSkippedElement();
+    else {
         std::stack<std::pair<std::shared_ptr<ui::element::Element>, Vector2>> stack;
         stack.push({ owner, offset });
 
@@ -167,9 +172,16 @@ Vector2 StackingContext::render(ScissorStack& scissorStack, const Vector2& paren
 
             // TODO : use scissor stack
 
-            if (!e->isNotDisplayed() && e->belongsTo(self)) {
+            if (e->isNotDisplayed()) {
+                RenderStats::Get().countSkippedElement();
+                continue;
+            }
+
+            if (e->belongsTo(self)) {
                 e->render(offset);
                 const auto rect = e->getBoundingRect();
+                RenderStats::Get().countPaintedElement(rect);
+                DebugOverlay::Get().recordRepaint(e);
                 const Vector2 newOffset { offset.x + rect.x, offset.y + rect.y };
 
                 for (auto child : e->getChildren())
@@ -183,6 +195,7 @@ Vector2 StackingContext::render(ScissorStack& scissorStack, const Vector2& paren
 }
 
 void StackingContext::renderTree() {
+    PROFILE_PHASE(profiling::Phase::Paint);
     ScissorStack scissorStack;
     std::stack<std::pair<std::shared_ptr<StackingContext>, Vector2>> stack;
     stack.push({ shared_from_this(), Vector2 { 0.0, 0.0 } });
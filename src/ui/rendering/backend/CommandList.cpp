@@ -0,0 +1,56 @@
+#include "./CommandList.h"
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+DrawCommand &CommandList::push(DrawCommand::Type type) {
+    auto &command = _commands.emplace_back();
+    command.type = type;
+    return command;
+}
+
+std::uint32_t CommandList::pushText(const char *text) {
+    const auto offset = _text.size();
+    _text.append(text);
+    _text.push_back('\0');
+    return offset;
+}
+
+int CommandList::fontIndexOf(const Font *font) {
+    if (!font)
+        return -1;
+
+    for (std::size_t i = 0; i < _fonts.size(); ++i)
+        if (_fonts[i].texture.id == font->texture.id)
+            return i;
+
+    _fonts.push_back(*font);
+    return _fonts.size() - 1;
+}
+
+const std::vector<DrawCommand> &CommandList::getCommands() const {
+    return _commands;
+}
+
+const char *CommandList::getText(const DrawCommand &command) const {
+    return _text.c_str() + command.textOffset;
+}
+
+const Font *CommandList::getFont(const DrawCommand &command) const {
+    return command.fontIndex >= 0 ? &_fonts[command.fontIndex] : nullptr;
+}
+
+bool CommandList::empty() const {
+    return _commands.empty();
+}
+
+void CommandList::clear() {
+    _commands.clear();
+    _text.clear();
+    _fonts.clear();
+}
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+struct DrawCommand {
+    enum class Type : std::uint8_t {
+        BeginRenderTarget,
+        EndRenderTarget,
+        Clear,
+        BeginScissor,
+        EndScissor,
+        Rectangle,
+        RoundedRectangle,
+        RectangleLines,
+        RoundedRectangleLines,
+        Line,
+        Text,
+        Texture
+    };
+
+    Type type;
+    ::Rectangle rect;     // shape, scissor or texture destination
+    ::Rectangle source;   // texture source
+    Vector2 points[2];    // line ends, text position or texture origin
+    float value;          // thickness, font size or rotation
+    float roundness;      // rounded shapes
+    int segments;         // rounded shapes
+    float spacing;        // text
+    int fontIndex;        // text, -1 for default font
+    Color color;
+    RenderTexture2D target;
+    Texture2D texture;
+    std::uint32_t textOffset; // in text arena, null terminated
+};
+
+/**
+ * Flat sequence of draw commands, texts being kept in a single arena.
+ * Storage is kept when cleared so that steady-state recording does not allocate.
+ */
+class CommandList {
+    std::vector<DrawCommand> _commands;
+    std::string _text;
+    std::vector<Font> _fonts;
+
+  public:
+    DrawCommand &push(DrawCommand::Type type);
+
+    // Copies `text` into arena, returns its offset
+    std::uint32_t pushText(const char *text);
+
+    // Index to store in `DrawCommand::fontIndex`, -1 for default font
+    int fontIndexOf(const Font *font);
+
+    const std::vector<DrawCommand> &getCommands() const;
+    const char *getText(const DrawCommand &command) const;
+    // `nullptr` for default font
+    const Font *getFont(const DrawCommand &command) const;
+
+    bool empty() const;
+    void clear();
+};
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
@@ -0,0 +1,131 @@
+#include "./Compositor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+std::uint32_t Compositor::Premultiply(Color color) {
+    auto pixel = Surface::Pack(color);
+    SpanKernels::Scalar().premultiply(&pixel, 1);
+    return pixel;
+}
+
+Color Compositor::Unpremultiply(std::uint32_t pixel) {
+    auto color = Surface::Unpack(pixel);
+    if (color.a == 0 || color.a == 255)
+        return color;
+
+    auto channel = [alpha = color.a](unsigned char value) {
+        return (unsigned char)std::min(255, (value * 255 + alpha / 2) / alpha);
+    };
+    return Color{channel(color.r), channel(color.g), channel(color.b), color.a};
+}
+
+void Compositor::Unpremultiply(std::uint32_t *pixels, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+        pixels[i] = Surface::Pack(Unpremultiply(pixels[i]));
+}
+
+std::pair<int, int> Compositor::PixelRange(float from, float to) {
+    return {(int)std::ceil(from - 0.5f), (int)std::ceil(to - 0.5f)};
+}
+
+std::optional<std::pair<float, float>> Compositor::ConvexSpan(const Vector2 *points, int count, float y) {
+    float minX = INFINITY, maxX = -INFINITY;
+    for (int i = 0; i < count; ++i) {
+        const auto &a = points[i];
+        const auto &b = points[(i + 1) % count];
+        if ((a.y <= y && y < b.y) || (b.y <= y && y < a.y)) {
+            const auto x = a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+        }
+    }
+
+    if (minX > maxX)
+        return std::nullopt;
+    return std::make_pair(minX, maxX);
+}
+
+void Compositor::Blit(Surface &target, const Box &clip,
+                      const Surface &texture, Rectangle source, const Rectangle &dest, Vector2 origin, float rotation,
+                      Color tint, Filter filter, std::vector<std::uint32_t> &scratch,
+                      const SpanKernels &kernels) {
+    if (texture.pixels.empty() || dest.width == 0 || dest.height == 0 || tint.a == 0)
+        return;
+
+    const bool flipX = source.width < 0;
+    const bool flipY = source.height < 0;
+    source.width = std::abs(source.width);
+    source.height = std::abs(source.height);
+
+    const auto radians = rotation * DEG2RAD;
+    const auto cosR = std::cos(radians), sinR = std::sin(radians);
+    auto toTarget = [&](float x, float y) {
+        x -= origin.x;
+        y -= origin.y;
+        return Vector2{dest.x + x * cosR - y * sinR, dest.y + x * sinR + y * cosR};
+    };
+    const Vector2 corners[4]{
+        toTarget(0, 0), toTarget(dest.width, 0), toTarget(dest.width, dest.height), toTarget(0, dest.height)};
+
+    float minY = INFINITY, maxY = -INFINITY;
+    for (const auto &corner : corners) {
+        minY = std::min(minY, corner.y);
+        maxY = std::max(maxY, corner.y);
+    }
+
+    // texels per target pixel along a row
+    const auto scaleX = (flipX ? -source.width : source.width) / dest.width;
+    const auto scaleY = (flipY ? -source.height : source.height) / dest.height;
+    const auto stepX = scaleX * cosR, stepY = -scaleY * sinR;
+
+    const auto packedTint = Premultiply(tint);
+    auto [y0, y1] = PixelRange(minY, maxY);
+    y0 = std::max(y0, clip.y0);
+    y1 = std::min(y1, clip.y1);
+
+    for (int y = y0; y < y1; ++y) {
+        const auto span = ConvexSpan(corners, 4, y + 0.5f);
+        if (!span)
+            continue;
+
+        auto [x0, x1] = PixelRange(span->first, span->second);
+        x0 = std::max(x0, clip.x0);
+        x1 = std::min(x1, clip.x1);
+        if (x0 >= x1)
+            continue;
+
+        // back to unrotated destination space, then to texels.
+        // Rows of bottom-up surfaces are already in OpenGL order, no special case.
+        const auto px = x0 + 0.5f - dest.x, py = y + 0.5f - dest.y;
+        const auto u = (px * cosR + py * sinR + origin.x) / dest.width;
+        const auto v = (-px * sinR + py * cosR + origin.y) / dest.height;
+        auto tx = source.x + (flipX ? 1 - u : u) * source.width;
+        auto ty = source.y + (flipY ? 1 - v : v) * source.height;
+
+        const auto count = x1 - x0;
+        scratch.resize(count);
+        if (filter == Filter::Bilinear) {
+            // texel centers on integers, 16.16 fixed point
+            auto fixed = [](float value) { return (std::int32_t)std::lround(value * 65536.0f); };
+            kernels.sampleBilinear(scratch.data(), count, texture, fixed(tx - 0.5f), fixed(ty - 0.5f), fixed(stepX), fixed(stepY));
+        } else {
+            for (int i = 0; i < count; ++i, tx += stepX, ty += stepY) {
+                const auto ix = std::clamp((int)std::floor(tx), 0, texture.width - 1);
+                const auto iy = std::clamp((int)std::floor(ty), 0, texture.height - 1);
+                scratch[i] = texture.row(iy)[ix];
+            }
+        }
+
+        kernels.modulate(scratch.data(), count, packedTint);
+        kernels.blend(target.scanline(y) + x0, scratch.data(), count);
+    }
+}
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "./SpanKernels.h"
+#include "./Surface.h"
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+/**
+ * Compositing routines on premultiplied RGBA8 surfaces, built on `SpanKernels`.
+ * `Blit` follows raylib `DrawTexturePro` geometry so that layers land at the same place
+ * whatever backend composites them.
+ */
+class Compositor {
+  public:
+    enum class Filter {
+        Nearest, // raylib default texture filter
+        Bilinear
+    };
+
+    static std::uint32_t Premultiply(Color color);
+    static Color Unpremultiply(std::uint32_t pixel);
+    static void Unpremultiply(std::uint32_t *pixels, std::size_t count);
+
+    // Pixels whose center lies in [from; to[
+    static std::pair<int, int> PixelRange(float from, float to);
+
+    // Horizontal extent of convex polygon at height `y`
+    static std::optional<std::pair<float, float>> ConvexSpan(const Vector2 *points, int count, float y);
+
+    // Draws `source` area of `texture` (negative size flips it) into `dest`, rotated by `rotation` degrees
+    // around `dest` position, `origin` being relative to it. Tint is straight alpha, opacity being a white tint.
+    // Only pixels of `target` within `clip` are written, `scratch` is grown to hold a row of samples.
+    static void Blit(Surface &target, const Box &clip,
+                     const Surface &texture, Rectangle source, const Rectangle &dest, Vector2 origin, float rotation,
+                     Color tint, Filter filter, std::vector<std::uint32_t> &scratch,
+                     const SpanKernels &kernels = SpanKernels::Get());
+};
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
@@ -0,0 +1,276 @@
+#include "./DrawBackend.h"
+#include "../RenderStats.h"
+#include "../RenderTargetPool.h"
+#include "./CommandList.h"
+#include "./RaylibBackend.h"
+
+#include <cstring>
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+std::unique_ptr<DrawBackend> DrawBackend::instance = nullptr;
+
+DrawBackend &DrawBackend::Get() {
+    if (!instance)
+        instance = std::make_unique<RaylibBackend>();
+
+    return *instance;
+}
+
+void DrawBackend::Set(std::unique_ptr<DrawBackend> backend) {
+    // pooled targets belong to the outgoing backend
+    if (instance)
+        RenderTargetPool::Get().clear();
+    instance = std::move(backend);
+}
+
+void DrawBackend::beginFrame() {
+    onBeginFrame();
+}
+
+void DrawBackend::endFrame() {
+    onEndFrame();
+    _presentedFrames++;
+}
+
+void DrawBackend::beginOffscreenPass() {
+    onBeginOffscreenPass();
+}
+
+void DrawBackend::endOffscreenPass() {
+    onEndOffscreenPass();
+}
+
+std::uint64_t DrawBackend::getPresentedFrameCount() const {
+    return _presentedFrames;
+}
+
+void DrawBackend::onBeginOffscreenPass() {
+    onBeginFrame();
+}
+
+void DrawBackend::onEndOffscreenPass() {
+    onEndFrame();
+}
+
+RenderTexture2D DrawBackend::loadRenderTarget(int width, int height) {
+    return onLoadRenderTarget(width, height);
+}
+
+void DrawBackend::unloadRenderTarget(const RenderTexture2D &target) {
+    onUnloadRenderTarget(target);
+}
+
+void DrawBackend::beginRenderTarget(const RenderTexture2D &target) {
+    RenderStats::Get().countRenderTargetSwitch();
+    onBeginRenderTarget(target);
+}
+
+void DrawBackend::endRenderTarget() {
+    onEndRenderTarget();
+}
+
+void DrawBackend::clear(Color color) {
+    onClear(color);
+}
+
+void DrawBackend::beginScissor(const Rectangle &rect) {
+    RenderStats::Get().countScissorChange();
+    onBeginScissor(rect);
+}
+
+void DrawBackend::endScissor() {
+    RenderStats::Get().countScissorChange();
+    onEndScissor();
+}
+
+void DrawBackend::drawRectangle(const Rectangle &rect, Color color) {
+    RenderStats::Get().countDrawCall(4);
+    onDrawRectangle(rect, color);
+}
+
+void DrawBackend::drawRectangleRounded(const Rectangle &rect, float roundness, int segments, Color color) {
+    RenderStats::Get().countDrawCall(RenderStats::RoundedRectangleVertices(segments));
+    onDrawRectangleRounded(rect, roundness, segments, color);
+}
+
+void DrawBackend::drawRectangleLines(const Rectangle &rect, float thickness, Color color) {
+    RenderStats::Get().countDrawCall(4 * 4);
+    onDrawRectangleLines(rect, thickness, color);
+}
+
+void DrawBackend::drawRectangleRoundedLines(const Rectangle &rect, float roundness, int segments, float thickness, Color color) {
+    RenderStats::Get().countDrawCall(RenderStats::RoundedRectangleVertices(segments));
+    onDrawRectangleRoundedLines(rect, roundness, segments, thickness, color);
+}
+
+void DrawBackend::drawLine(Vector2 start, Vector2 end, float thickness, Color color) {
+    RenderStats::Get().countDrawCall(4);
+    onDrawLine(start, end, thickness, color);
+}
+
+void DrawBackend::drawRectangleEdges(const Rectangle &rect,
+                                     float top, float bottom, float left, float right,
+                                     const Color &topColor, const Color &bottomColor, const Color &leftColor, const Color &rightColor) {
+    auto divBy2 = [](float num) { return num <= 1.0 ? num : (num / 2); };
+
+    if (top > 0.0 && topColor.a > 0)
+        drawLine(Vector2{.x = rect.x, .y = rect.y + divBy2(top)},
+                 Vector2{.x = rect.x + rect.width, .y = rect.y + divBy2(top)},
+                 top, topColor);
+
+    if (left > 0.0 && leftColor.a > 0)
+        drawLine(Vector2{.x = rect.x + divBy2(left), .y = rect.y},
+                 Vector2{.x = rect.x + divBy2(left), .y = rect.y + rect.height},
+                 left, leftColor);
+
+    if (bottom > 0.0 && bottomColor.a > 0)
+        drawLine(Vector2{.x = rect.x, .y = rect.y + rect.height - divBy2(bottom)},
+                 Vector2{.x = rect.x + rect.width,
+                         .y = rect.y + rect.height - divBy2(bottom)},
+                 bottom, bottomColor);
+
+    if (right > 0.0 && rightColor.a > 0)
+        drawLine(Vector2{.x = rect.x + rect.width - divBy2(right), .y = rect.y},
+                 Vector2{.x = rect.x + rect.width - divBy2(right),
+                         .y = rect.y + rect.height},
+                 right, rightColor);
+}
+
+void DrawBackend::drawText(const Font *font, const char *text, Vector2 position, float fontSize, float spacing, Color color) {
+    RenderStats::Get().countTextDrawCall(text);
+    onDrawText(font, text, position, fontSize, spacing, color);
+}
+
+void DrawBackend::drawTexture(const Texture2D &texture, const Rectangle &source, const Rectangle &dest, Vector2 origin, float rotation, Color tint) {
+    RenderStats::Get().countDrawCall(4);
+    onDrawTexture(texture, source, dest, origin, rotation, tint);
+}
+
+void DrawBackend::drawTexture(const Texture2D &texture, Vector2 position, Color tint) {
+    drawTexture(texture,
+                Rectangle{0, 0, (float)texture.width, (float)texture.height},
+                Rectangle{position.x, position.y, (float)texture.width, (float)texture.height},
+                Vector2{0, 0}, 0.0, tint);
+}
+
+Vector2 DrawBackend::measureText(const Font *font, const char *text, float fontSize, float spacing) const {
+    if (font)
+        return MeasureTextEx(*font, text, fontSize, spacing);
+
+    return Vector2{(float)MeasureText(text, fontSize), fontSize};
+}
+
+Texture2D DrawBackend::loadTexture(const ::Image &image) {
+    return onLoadTexture(image);
+}
+
+void DrawBackend::unloadTexture(const Texture2D &texture) {
+    if (texture.id != 0)
+        onUnloadTexture(texture);
+}
+
+std::optional<Font> DrawBackend::loadFont(const std::filesystem::path &path) {
+    constexpr int BaseSize = 32;   // FONT_TTF_DEFAULT_SIZE
+    constexpr int GlyphCount = 95; // FONT_TTF_DEFAULT_NUMCHARS
+    constexpr int GlyphPadding = 4;
+
+    int dataSize = 0;
+    auto data = LoadFileData(path.string().c_str(), &dataSize);
+    if (!data)
+        return std::nullopt;
+
+    Font font{};
+    font.baseSize = BaseSize;
+    font.glyphCount = GlyphCount;
+    font.glyphPadding = GlyphPadding;
+    font.glyphs = LoadFontData(data, dataSize, font.baseSize, nullptr, font.glyphCount, FONT_DEFAULT);
+    UnloadFileData(data);
+
+    if (!font.glyphs)
+        return std::nullopt;
+
+    auto atlas = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, font.baseSize, font.glyphPadding, 0);
+    font.texture = loadTexture(atlas);
+
+    // same as raylib : keep glyph images cropped from the atlas
+    for (int i = 0; i < font.glyphCount; ++i) {
+        UnloadImage(font.glyphs[i].image);
+        font.glyphs[i].image = ImageFromImage(atlas, font.recs[i]);
+    }
+    UnloadImage(atlas);
+
+    if (font.texture.id == 0) {
+        unloadFont(font);
+        return std::nullopt;
+    }
+
+    return font;
+}
+
+void DrawBackend::unloadFont(const Font &font) {
+    onUnloadFont(font);
+}
+
+void DrawBackend::onUnloadFont(const Font &font) {
+    UnloadFontData(font.glyphs, font.glyphCount);
+    MemFree(font.recs);
+    unloadTexture(font.texture);
+}
+
+void DrawBackend::waitEvents(std::optional<std::chrono::steady_clock::time_point>) {}
+
+void DrawBackend::wakeEvents() {}
+
+bool DrawBackend::readPixels(const RenderTexture2D &target, std::vector<Color> &pixels) {
+    return onReadPixels(target, pixels);
+}
+
+void DrawBackend::submit(const CommandList &commands) {
+    for (const auto &command : commands.getCommands()) {
+        switch (command.type) {
+        case DrawCommand::Type::BeginRenderTarget:
+            onBeginRenderTarget(command.target);
+            break;
+        case DrawCommand::Type::EndRenderTarget:
+            onEndRenderTarget();
+            break;
+        case DrawCommand::Type::Clear:
+            onClear(command.color);
+            break;
+        case DrawCommand::Type::BeginScissor:
+            onBeginScissor(command.rect);
+            break;
+        case DrawCommand::Type::EndScissor:
+            onEndScissor();
+            break;
+        case DrawCommand::Type::Rectangle:
+            onDrawRectangle(command.rect, command.color);
+            break;
+        case DrawCommand::Type::RoundedRectangle:
+            onDrawRectangleRounded(command.rect, command.roundness, command.segments, command.color);
+            break;
+        case DrawCommand::Type::RectangleLines:
+            onDrawRectangleLines(command.rect, command.value, command.color);
+            break;
+        case DrawCommand::Type::RoundedRectangleLines:
+            onDrawRectangleRoundedLines(command.rect, command.roundness, command.segments, command.value, command.color);
+            break;
+        case DrawCommand::Type::Line:
+            onDrawLine(command.points[0], command.points[1], command.value, command.color);
+            break;
+        case DrawCommand::Type::Text:
+            onDrawText(commands.getFont(command), commands.getText(command), command.points[0], command.value, command.spacing, command.color);
+            break;
+        case DrawCommand::Type::Texture:
+            onDrawTexture(command.texture, command.source, command.rect, command.points[0], command.value, command.color);
+            break;
+        }
+    }
+}
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+class CommandList; // forward declaration
+
+/**
+ * Every paint, render target and GPU resource operation goes through the current backend.
+ * Public methods are non-virtual : they update `RenderStats` then forward to the implementation,
+ * so that counters stay identical whatever backend is in use.
+ * Fonts and images are decoded on CPU and only uploaded through `loadTexture`,
+ * which lets non-GPU backends run without any window or graphics context.
+ */
+class DrawBackend {
+    static std::unique_ptr<DrawBackend> instance;
+
+    std::uint64_t _presentedFrames = 0;
+
+  protected:
+    virtual void onBeginFrame() = 0;
+    virtual void onEndFrame() = 0;
+
+    // Same as a frame by default, backends presenting to a window only draw into render targets
+    virtual void onBeginOffscreenPass();
+    virtual void onEndOffscreenPass();
+
+    virtual RenderTexture2D onLoadRenderTarget(int width, int height) = 0;
+    virtual void onUnloadRenderTarget(const RenderTexture2D &target) = 0;
+    virtual void onBeginRenderTarget(const RenderTexture2D &target) = 0;
+    virtual void onEndRenderTarget() = 0;
+    virtual void onClear(Color color) = 0;
+
+    virtual void onBeginScissor(const Rectangle &rect) = 0;
+    virtual void onEndScissor() = 0;
+
+    virtual void onDrawRectangle(const Rectangle &rect, Color color) = 0;
+    virtual void onDrawRectangleRounded(const Rectangle &rect, float roundness, int segments, Color color) = 0;
+    virtual void onDrawRectangleLines(const Rectangle &rect, float thickness, Color color) = 0;
+    virtual void onDrawRectangleRoundedLines(const Rectangle &rect, float roundness, int segments, float thickness, Color color) = 0;
+    virtual void onDrawLine(Vector2 start, Vector2 end, float thickness, Color color) = 0;
+    virtual void onDrawText(const Font *font, const char *text, Vector2 position, float fontSize, float spacing, Color color) = 0;
+    virtual void onDrawTexture(const Texture2D &texture, const Rectangle &source, const Rectangle &dest, Vector2 origin, float rotation, Color tint) = 0;
+
+    virtual Texture2D onLoadTexture(const ::Image &image) = 0;
+    virtual void onUnloadTexture(const Texture2D &texture) = 0;
+
+    // Frees glyphs then unloads atlas, backends replaying recorded frames later defer it
+    virtual void onUnloadFont(const Font &font);
+
+    virtual bool onReadPixels(const RenderTexture2D &target, std::vector<Color> &pixels) = 0;
+
+  public:
+    virtual ~DrawBackend() = default;
+
+    // Current backend, raylib one is created if none has been set
+    static DrawBackend &Get();
+
+    // Must be called before any GPU resource is loaded
+    static void Set(std::unique_ptr<DrawBackend> backend);
+
+    // `true` if backend needs a window and a graphics context
+    virtual bool needsWindow() const = 0;
+
+    virtual int getScreenWidth() const = 0;
+    virtual int getScreenHeight() const = 0;
+
+    // Resizes window, or frame buffer of offscreen backends
+    virtual void setScreenSize(int width, int height) = 0;
+
+    // Blocks until window events arrive, `wakeEvents` is called or `deadline` passes, then polls them.
+    // Returns right away for backends without window events
+    virtual void waitEvents(std::optional<std::chrono::steady_clock::time_point> deadline);
+
+    // Ends `waitEvents`, may be called from any thread
+    virtual void wakeEvents();
+
+    void beginFrame();
+    void endFrame();
+
+    // Draws into render targets only : nothing is presented and window input is left untouched
+    void beginOffscreenPass();
+    void endOffscreenPass();
+
+    // Frames ended since creation, offscreen passes excluded
+    std::uint64_t getPresentedFrameCount() const;
+
+    RenderTexture2D loadRenderTarget(int width, int height);
+    void unloadRenderTarget(const RenderTexture2D &target);
+    void beginRenderTarget(const RenderTexture2D &target);
+    void endRenderTarget();
+    void clear(Color color);
+
+    void beginScissor(const Rectangle &rect);
+    void endScissor();
+
+    void drawRectangle(const Rectangle &rect, Color color);
+    void drawRectangleRounded(const Rectangle &rect, float roundness, int segments, Color color);
+    void drawRectangleLines(const Rectangle &rect, float thickness, Color color);
+    void drawRectangleRoundedLines(const Rectangle &rect, float roundness, int segments, float thickness, Color color);
+    void drawLine(Vector2 start, Vector2 end, float thickness, Color color);
+
+    // Draw rectangle by drawing four edges individualy
+    void drawRectangleEdges(const Rectangle &rect,
+                            float top, float bottom, float left, float right,
+                            const Color &topColor, const Color &bottomColor, const Color &leftColor, const Color &rightColor);
+
+    // @param font `nullptr` for raylib default font, spacing is then ignored
+    void drawText(const Font *font, const char *text, Vector2 position, float fontSize, float spacing, Color color);
+    void drawTexture(const Texture2D &texture, const Rectangle &source, const Rectangle &dest, Vector2 origin, float rotation, Color tint);
+    void drawTexture(const Texture2D &texture, Vector2 position, Color tint);
+
+    // @param font `nullptr` for raylib default font, spacing is then ignored
+    virtual Vector2 measureText(const Font *font, const char *text, float fontSize, float spacing) const;
+
+    // Uploads CPU image, `image` is left untouched
+    Texture2D loadTexture(const ::Image &image);
+    void unloadTexture(const Texture2D &texture);
+
+    // Decodes font on CPU then uploads glyph atlas, same defaults as raylib `LoadFont`
+    std::optional<Font> loadFont(const std::filesystem::path &path);
+    void unloadFont(const Font &font);
+
+    // Copies content of `target` into `pixels` once frame has ended : top-down rows, straight alpha.
+    // `pixels` storage is reused, returns `false` if backend does not keep pixels
+    bool readPixels(const RenderTexture2D &target, std::vector<Color> &pixels);
+
+    // Replays recorded commands, resources ids must be valid for this backend.
+    // `RenderStats` is left untouched, commands have been counted while recording
+    void submit(const CommandList &commands);
+};
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
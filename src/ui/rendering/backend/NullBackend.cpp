@@ -0,0 +1,101 @@
+#include "./NullBackend.h"
+
+#include <cstring>
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+NullBackend::NullBackend(int screenWidth, int screenHeight)
+    : _screenWidth(screenWidth), _screenHeight(screenHeight), _nextResourceId(1) {}
+
+unsigned int NullBackend::nextResourceId() {
+    return _nextResourceId++;
+}
+
+void NullBackend::setScreenSize(int width, int height) {
+    _screenWidth = width;
+    _screenHeight = height;
+}
+
+bool NullBackend::needsWindow() const {
+    return false;
+}
+
+int NullBackend::getScreenWidth() const {
+    return _screenWidth;
+}
+
+int NullBackend::getScreenHeight() const {
+    return _screenHeight;
+}
+
+Vector2 NullBackend::measureText(const Font *font, const char *text, float fontSize, float spacing) const {
+    if (font)
+        return MeasureTextEx(*font, text, fontSize, spacing);
+
+    // raylib default font glyphs are about 6/10 of font size wide, spacing included
+    return Vector2{std::strlen(text) * fontSize * 0.6f, fontSize};
+}
+
+void NullBackend::onBeginFrame() {}
+
+void NullBackend::onEndFrame() {}
+
+RenderTexture2D NullBackend::onLoadRenderTarget(int width, int height) {
+    RenderTexture2D target{};
+    target.id = nextResourceId();
+    target.texture = Texture2D{
+        .id = nextResourceId(),
+        .width = width,
+        .height = height,
+        .mipmaps = 1,
+        .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+    target.depth = Texture2D{.id = nextResourceId(), .width = width, .height = height};
+    return target;
+}
+
+void NullBackend::onUnloadRenderTarget(const RenderTexture2D &) {}
+
+void NullBackend::onBeginRenderTarget(const RenderTexture2D &) {}
+
+void NullBackend::onEndRenderTarget() {}
+
+void NullBackend::onClear(Color) {}
+
+void NullBackend::onBeginScissor(const Rectangle &) {}
+
+void NullBackend::onEndScissor() {}
+
+void NullBackend::onDrawRectangle(const Rectangle &, Color) {}
+
+void NullBackend::onDrawRectangleRounded(const Rectangle &, float, int, Color) {}
+
+void NullBackend::onDrawRectangleLines(const Rectangle &, float, Color) {}
+
+void NullBackend::onDrawRectangleRoundedLines(const Rectangle &, float, int, float, Color) {}
+
+void NullBackend::onDrawLine(Vector2, Vector2, float, Color) {}
+
+void NullBackend::onDrawText(const Font *, const char *, Vector2, float, float, Color) {}
+
+void NullBackend::onDrawTexture(const Texture2D &, const Rectangle &, const Rectangle &, Vector2, float, Color) {}
+
+Texture2D NullBackend::onLoadTexture(const ::Image &image) {
+    return Texture2D{
+        .id = nextResourceId(),
+        .width = image.width,
+        .height = image.height,
+        .mipmaps = image.mipmaps,
+        .format = image.format};
+}
+
+void NullBackend::onUnloadTexture(const Texture2D &) {}
+
+bool NullBackend::onReadPixels(const RenderTexture2D &, std::vector<Color> &) {
+    return false;
+}
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
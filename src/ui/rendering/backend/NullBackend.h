@@ -0,0 +1,61 @@
+#pragma once
+
+#include "./DrawBackend.h"
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+/**
+ * Discards every draw command, GPU resources are replaced by ids only.
+ * Needs neither window nor graphics context : used to measure CPU-side paint cost.
+ * Default font is not available without window, its text size is approximated.
+ */
+class NullBackend : public DrawBackend {
+    int _screenWidth;
+    int _screenHeight;
+    unsigned int _nextResourceId;
+
+  protected:
+    unsigned int nextResourceId();
+
+    void onBeginFrame() override;
+    void onEndFrame() override;
+
+    RenderTexture2D onLoadRenderTarget(int width, int height) override;
+    void onUnloadRenderTarget(const RenderTexture2D &target) override;
+    void onBeginRenderTarget(const RenderTexture2D &target) override;
+    void onEndRenderTarget() override;
+    void onClear(Color color) override;
+
+    void onBeginScissor(const Rectangle &rect) override;
+    void onEndScissor() override;
+
+    void onDrawRectangle(const Rectangle &rect, Color color) override;
+    void onDrawRectangleRounded(const Rectangle &rect, float roundness, int segments, Color color) override;
+    void onDrawRectangleLines(const Rectangle &rect, float thickness, Color color) override;
+    void onDrawRectangleRoundedLines(const Rectangle &rect, float roundness, int segments, float thickness, Color color) override;
+    void onDrawLine(Vector2 start, Vector2 end, float thickness, Color color) override;
+    void onDrawText(const Font *font, const char *text, Vector2 position, float fontSize, float spacing, Color color) override;
+    void onDrawTexture(const Texture2D &texture, const Rectangle &source, const Rectangle &dest, Vector2 origin, float rotation, Color tint) override;
+
+    Texture2D onLoadTexture(const ::Image &image) override;
+    void onUnloadTexture(const Texture2D &texture) override;
+
+    bool onReadPixels(const RenderTexture2D &target, std::vector<Color> &pixels) override;
+
+  public:
+    NullBackend(int screenWidth, int screenHeight);
+
+    void setScreenSize(int width, int height) override;
+
+    bool needsWindow() const override;
+    int getScreenWidth() const override;
+    int getScreenHeight() const override;
+
+    Vector2 measureText(const Font *font, const char *text, float fontSize, float spacing) const override;
+};
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
@@ -0,0 +1,165 @@
+#include "./RaylibBackend.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if defined(PLATFORM_DESKTOP)
+// part of GLFW, which raylib desktop platform is built upon, its header is not exported
+extern "C" void glfwPostEmptyEvent(void);
+#endif
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+bool RaylibBackend::needsWindow() const {
+    return true;
+}
+
+int RaylibBackend::getScreenWidth() const {
+    return GetScreenWidth();
+}
+
+int RaylibBackend::getScreenHeight() const {
+    return GetScreenHeight();
+}
+
+void RaylibBackend::setScreenSize(int width, int height) {
+    SetWindowSize(width, height);
+}
+
+void RaylibBackend::waitEvents(std::optional<std::chrono::steady_clock::time_point> deadline) {
+#if defined(PLATFORM_DESKTOP)
+    // raylib waits without timeout, an empty event ends it at deadline
+    std::jthread timer;
+    if (deadline)
+        timer = std::jthread([deadline = *deadline](std::stop_token stop) {
+            std::mutex mutex;
+            std::condition_variable_any condition;
+            std::unique_lock lock(mutex);
+            if (!condition.wait_until(lock, stop, deadline, [] { return false; }) && !stop.stop_requested())
+                glfwPostEmptyEvent();
+        });
+
+    EnableEventWaiting();
+    PollInputEvents();
+    DisableEventWaiting();
+#else
+    // no thread-safe wake up : short sleeps keep input and `wakeEvents` latency low
+    constexpr auto Slice = std::chrono::milliseconds(10);
+    auto until = std::chrono::steady_clock::now() + Slice;
+    if (deadline)
+        until = std::min(until, *deadline);
+
+    const auto remaining = std::chrono::duration<double>(until - std::chrono::steady_clock::now()).count();
+    if (remaining > 0)
+        WaitTime(remaining);
+    PollInputEvents();
+#endif
+}
+
+void RaylibBackend::wakeEvents() {
+#if defined(PLATFORM_DESKTOP)
+    glfwPostEmptyEvent();
+#endif
+}
+
+void RaylibBackend::onBeginFrame() {
+    BeginDrawing();
+}
+
+void RaylibBackend::onEndFrame() {
+    EndDrawing();
+}
+
+void RaylibBackend::onBeginOffscreenPass() {}
+
+void RaylibBackend::onEndOffscreenPass() {}
+
+RenderTexture2D RaylibBackend::onLoadRenderTarget(int width, int height) {
+    return LoadRenderTexture(width, height);
+}
+
+void RaylibBackend::onUnloadRenderTarget(const RenderTexture2D &target) {
+    UnloadRenderTexture(target);
+}
+
+void RaylibBackend::onBeginRenderTarget(const RenderTexture2D &target) {
+    BeginTextureMode(target);
+}
+
+void RaylibBackend::onEndRenderTarget() {
+    EndTextureMode();
+}
+
+void RaylibBackend::onClear(Color color) {
+    ClearBackground(color);
+}
+
+void RaylibBackend::onBeginScissor(const Rectangle &rect) {
+    BeginScissorMode(rect.x, rect.y, rect.width, rect.height);
+}
+
+void RaylibBackend::onEndScissor() {
+    EndScissorMode();
+}
+
+void RaylibBackend::onDrawRectangle(const Rectangle &rect, Color color) {
+    DrawRectangle(rect.x, rect.y, rect.width, rect.height, color);
+}
+
+void RaylibBackend::onDrawRectangleRounded(const Rectangle &rect, float roundness, int segments, Color color) {
+    DrawRectangleRounded(rect, roundness, segments, color);
+}
+
+void RaylibBackend::onDrawRectangleLines(const Rectangle &rect, float thickness, Color color) {
+    DrawRectangleLinesEx(rect, thickness, color);
+}
+
+void RaylibBackend::onDrawRectangleRoundedLines(const Rectangle &rect, float roundness, int segments, float thickness, Color color) {
+    DrawRectangleRoundedLines(rect, roundness, segments, thickness, color);
+}
+
+void RaylibBackend::onDrawLine(Vector2 start, Vector2 end, float thickness, Color color) {
+    DrawLineEx(start, end, thickness, color);
+}
+
+void RaylibBackend::onDrawText(const Font *font, const char *text, Vector2 position, float fontSize, float spacing, Color color) {
+    if (font)
+        DrawTextEx(*font, text, position, fontSize, spacing, color);
+    else
+        DrawText(text, position.x, position.y, fontSize, color);
+}
+
+void RaylibBackend::onDrawTexture(const Texture2D &texture, const Rectangle &source, const Rectangle &dest, Vector2 origin, float rotation, Color tint) {
+    DrawTexturePro(texture, source, dest, origin, rotation, tint);
+}
+
+Texture2D RaylibBackend::onLoadTexture(const ::Image &image) {
+    return LoadTextureFromImage(image);
+}
+
+void RaylibBackend::onUnloadTexture(const Texture2D &texture) {
+    UnloadTexture(texture);
+}
+
+bool RaylibBackend::onReadPixels(const RenderTexture2D &target, std::vector<Color> &pixels) {
+    auto image = LoadImageFromTexture(target.texture);
+    if (!image.data)
+        return false;
+
+    // OpenGL rows are bottom-up
+    ImageFlipVertical(&image);
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    const auto data = (const Color *)image.data;
+    pixels.assign(data, data + std::size_t(image.width) * image.height);
+    UnloadImage(image);
+    return true;
+}
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "./DrawBackend.h"
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+// Immediate mode raylib drawing, needs a window
+class RaylibBackend : public DrawBackend {
+  protected:
+    void onBeginFrame() override;
+    void onEndFrame() override;
+
+    // Outside `BeginDrawing` : render textures are drawn, the back buffer is neither swapped nor input polled
+    void onBeginOffscreenPass() override;
+    void onEndOffscreenPass() override;
+
+    RenderTexture2D onLoadRenderTarget(int width, int height) override;
+    void onUnloadRenderTarget(const RenderTexture2D &target) override;
+    void onBeginRenderTarget(const RenderTexture2D &target) override;
+    void onEndRenderTarget() override;
+    void onClear(Color color) override;
+
+    void onBeginScissor(const Rectangle &rect) override;
+    void onEndScissor() override;
+
+    void onDrawRectangle(const Rectangle &rect, Color color) override;
+    void onDrawRectangleRounded(const Rectangle &rect, float roundness, int segments, Color color) override;
+    void onDrawRectangleLines(const Rectangle &rect, float thickness, Color color) override;
+    void onDrawRectangleRoundedLines(const Rectangle &rect, float roundness, int segments, float thickness, Color color) override;
+    void onDrawLine(Vector2 start, Vector2 end, float thickness, Color color) override;
+    void onDrawText(const Font *font, const char *text, Vector2 position, float fontSize, float spacing, Color color) override;
+    void onDrawTexture(const Texture2D &texture, const Rectangle &source, const Rectangle &dest, Vector2 origin, float rotation, Color tint) override;
+
+    Texture2D onLoadTexture(const ::Image &image) override;
+    void onUnloadTexture(const Texture2D &texture) override;
+
+    bool onReadPixels(const RenderTexture2D &target, std::vector<Color> &pixels) override;
+
+  public:
+    bool needsWindow() const override;
+    int getScreenWidth() const override;
+    int getScreenHeight() const override;
+    void setScreenSize(int width, int height) override;
+
+    // Desktop platform waits on GLFW, others sleep a few milliseconds at most and cannot be woken
+    void waitEvents(std::optional<std::chrono::steady_clock::time_point> deadline) override;
+    void wakeEvents() override;
+};
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
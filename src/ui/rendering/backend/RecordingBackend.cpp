@@ -0,0 +1,134 @@
+#include "./RecordingBackend.h"
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+RecordingBackend::RecordingBackend(int screenWidth, int screenHeight) : NullBackend(screenWidth, screenHeight) {}
+
+RecordingBackend::~RecordingBackend() {
+    clear();
+}
+
+const CommandList &RecordingBackend::getCommandList() const {
+    return _commands;
+}
+
+const std::vector<DrawCommand> &RecordingBackend::getCommands() const {
+    return _commands.getCommands();
+}
+
+const char *RecordingBackend::getText(const DrawCommand &command) const {
+    return _commands.getText(command);
+}
+
+const Font *RecordingBackend::getFont(const DrawCommand &command) const {
+    return _commands.getFont(command);
+}
+
+void RecordingBackend::clear() {
+    _commands.clear();
+
+    std::vector<Font> retired;
+    {
+        std::lock_guard lock(_retiredFontsMutex);
+        retired.swap(_retiredFonts);
+    }
+    for (const auto &font : retired)
+        DrawBackend::onUnloadFont(font);
+}
+
+void RecordingBackend::onUnloadFont(const Font &font) {
+    std::lock_guard lock(_retiredFontsMutex);
+    _retiredFonts.push_back(font);
+}
+
+void RecordingBackend::onBeginFrame() {
+    clear();
+}
+
+void RecordingBackend::onBeginRenderTarget(const RenderTexture2D &target) {
+    _commands.push(DrawCommand::Type::BeginRenderTarget).target = target;
+}
+
+void RecordingBackend::onEndRenderTarget() {
+    _commands.push(DrawCommand::Type::EndRenderTarget);
+}
+
+void RecordingBackend::onClear(Color color) {
+    _commands.push(DrawCommand::Type::Clear).color = color;
+}
+
+void RecordingBackend::onBeginScissor(const Rectangle &rect) {
+    _commands.push(DrawCommand::Type::BeginScissor).rect = rect;
+}
+
+void RecordingBackend::onEndScissor() {
+    _commands.push(DrawCommand::Type::EndScissor);
+}
+
+void RecordingBackend::onDrawRectangle(const Rectangle &rect, Color color) {
+    auto &command = _commands.push(DrawCommand::Type::Rectangle);
+    command.rect = rect;
+    command.color = color;
+}
+
+void RecordingBackend::onDrawRectangleRounded(const Rectangle &rect, float roundness, int segments, Color color) {
+    auto &command = _commands.push(DrawCommand::Type::RoundedRectangle);
+    command.rect = rect;
+    command.roundness = roundness;
+    command.segments = segments;
+    command.color = color;
+}
+
+void RecordingBackend::onDrawRectangleLines(const Rectangle &rect, float thickness, Color color) {
+    auto &command = _commands.push(DrawCommand::Type::RectangleLines);
+    command.rect = rect;
+    command.value = thickness;
+    command.color = color;
+}
+
+void RecordingBackend::onDrawRectangleRoundedLines(const Rectangle &rect, float roundness, int segments, float thickness, Color color) {
+    auto &command = _commands.push(DrawCommand::Type::RoundedRectangleLines);
+    command.rect = rect;
+    command.roundness = roundness;
+    command.segments = segments;
+    command.value = thickness;
+    command.color = color;
+}
+
+void RecordingBackend::onDrawLine(Vector2 start, Vector2 end, float thickness, Color color) {
+    auto &command = _commands.push(DrawCommand::Type::Line);
+    command.points[0] = start;
+    command.points[1] = end;
+    command.value = thickness;
+    command.color = color;
+}
+
+void RecordingBackend::onDrawText(const Font *font, const char *text, Vector2 position, float fontSize, float spacing, Color color) {
+    auto &command = _commands.push(DrawCommand::Type::Text);
+    command.points[0] = position;
+    command.value = fontSize;
+    command.spacing = spacing;
+    command.fontIndex = _commands.fontIndexOf(font);
+    command.color = color;
+    command.textOffset = _commands.pushText(text);
+}
+
+void RecordingBackend::onDrawTexture(const Texture2D &texture, const Rectangle &source, const Rectangle &dest, Vector2 origin, float rotation, Color tint) {
+    auto &command = _commands.push(DrawCommand::Type::Texture);
+    command.texture = texture;
+    command.source = source;
+    command.rect = dest;
+    command.points[0] = origin;
+    command.value = rotation;
+    command.color = tint;
+}
+
+void RecordingBackend::replay(DrawBackend &backend) const {
+    backend.submit(_commands);
+}
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "./CommandList.h"
+#include "./NullBackend.h"
+
+#include <mutex>
+#include <vector>
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+/**
+ * Records draw commands into memory instead of submitting them.
+ * Commands are cleared at the beginning of every frame, storage is kept between frames
+ * so that steady-state recording does not allocate.
+ * Resources are ids only, as with `NullBackend`.
+ * Recorded text keeps glyph pointers : fonts are unloaded once commands are cleared.
+ */
+class RecordingBackend : public NullBackend {
+    std::vector<Font> _retiredFonts;
+    std::mutex _retiredFontsMutex; // fonts may be released from any thread
+
+  protected:
+    CommandList _commands;
+
+    void onBeginFrame() override;
+
+    void onBeginRenderTarget(const RenderTexture2D &target) override;
+    void onEndRenderTarget() override;
+    void onClear(Color color) override;
+
+    void onBeginScissor(const Rectangle &rect) override;
+    void onEndScissor() override;
+
+    void onDrawRectangle(const Rectangle &rect, Color color) override;
+    void onDrawRectangleRounded(const Rectangle &rect, float roundness, int segments, Color color) override;
+    void onDrawRectangleLines(const Rectangle &rect, float thickness, Color color) override;
+    void onDrawRectangleRoundedLines(const Rectangle &rect, float roundness, int segments, float thickness, Color color) override;
+    void onDrawLine(Vector2 start, Vector2 end, float thickness, Color color) override;
+    void onDrawText(const Font *font, const char *text, Vector2 position, float fontSize, float spacing, Color color) override;
+    void onDrawTexture(const Texture2D &texture, const Rectangle &source, const Rectangle &dest, Vector2 origin, float rotation, Color tint) override;
+
+    void onUnloadFont(const Font &font) override;
+
+  public:
+    RecordingBackend(int screenWidth, int screenHeight);
+    ~RecordingBackend();
+
+    const CommandList &getCommandList() const;
+    const std::vector<DrawCommand> &getCommands() const;
+    const char *getText(const DrawCommand &command) const;
+    // `nullptr` for default font
+    const Font *getFont(const DrawCommand &command) const;
+
+    void clear();
+
+    // Submits recorded commands to `backend`, resources ids must be valid for it
+    void replay(DrawBackend &backend) const;
+};
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
@@ -0,0 +1,508 @@
+#include "./SoftwareBackend.h"
+#include "../../../core/ThreadPool.h"
+#include "../../../core/profiling/Tracer.h"
+#include "./Compositor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <optional>
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+namespace {
+
+// raylib default vertical space between lines of text
+constexpr float TextLineSpacing = 2.0;
+// raylib `DrawText` minimum size, spacing grows by 1 per multiple of it
+constexpr int DefaultFontSize = 10;
+
+// Premultiplied copy of `image`, `false` if its format cannot be converted
+bool copyPixels(const ::Image &image, Surface &surface) {
+    auto copy = ImageCopy(image);
+    ImageFormat(&copy, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    const bool copied = copy.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 && copy.data;
+    if (copied) {
+        std::memcpy(surface.pixels.data(), copy.data, surface.pixels.size() * sizeof(std::uint32_t));
+        SpanKernels::Get().premultiply(surface.pixels.data(), surface.pixels.size());
+    }
+    UnloadImage(copy);
+    return copied;
+}
+
+Box boundsOf(float minX, float minY, float maxX, float maxY) {
+    return Box{(int)std::floor(minX), (int)std::floor(minY), (int)std::ceil(maxX), (int)std::ceil(maxY)};
+}
+
+Box boundsOf(const Rectangle &rect, float margin = 0.0) {
+    return boundsOf(rect.x - margin, rect.y - margin, rect.x + rect.width + margin, rect.y + rect.height + margin);
+}
+
+// raylib rounded rectangle radius
+float radiusOf(const Rectangle &rect, float roundness) {
+    roundness = std::min(roundness, 1.0f);
+    return (rect.width > rect.height ? rect.height * roundness : rect.width * roundness) / 2;
+}
+
+// Horizontal extent of rounded rectangle at height `y`
+std::optional<std::pair<float, float>> roundedSpan(const Rectangle &rect, float radius, float y) {
+    if (y < rect.y || y >= rect.y + rect.height)
+        return std::nullopt;
+
+    float dy = 0.0;
+    if (y < rect.y + radius)
+        dy = rect.y + radius - y;
+    else if (y > rect.y + rect.height - radius)
+        dy = y - (rect.y + rect.height - radius);
+
+    const auto inset = radius - std::sqrt(std::max(0.0f, radius * radius - dy * dy));
+    return std::make_pair(rect.x + inset, rect.x + rect.width - inset);
+}
+
+/**
+ * Rasterizes into a surface, every write is restricted to `clip`.
+ */
+struct Canvas {
+    Surface &surface;
+    Box clip;
+    const SpanKernels &kernels;
+    std::vector<std::uint32_t> &scratch;
+
+    void fillSpan(int y, float from, float to, std::uint32_t color) {
+        auto [x0, x1] = Compositor::PixelRange(from, to);
+        x0 = std::max(x0, clip.x0);
+        x1 = std::min(x1, clip.x1);
+        if (x0 < x1)
+            kernels.fill(surface.scanline(y) + x0, x1 - x0, color);
+    }
+
+    std::pair<int, int> rows(float from, float to) const {
+        const auto [y0, y1] = Compositor::PixelRange(from, to);
+        return {std::max(y0, clip.y0), std::min(y1, clip.y1)};
+    }
+
+    void clear(std::uint32_t color) {
+        for (int y = clip.y0; y < clip.y1; ++y)
+            std::fill(surface.scanline(y) + clip.x0, surface.scanline(y) + clip.x1, color);
+    }
+
+    void fillRectangle(const Rectangle &rect, std::uint32_t color) {
+        const auto [y0, y1] = rows(rect.y, rect.y + rect.height);
+        for (int y = y0; y < y1; ++y)
+            fillSpan(y, rect.x, rect.x + rect.width, color);
+    }
+
+    void fillRoundedRectangle(const Rectangle &rect, float roundness, std::uint32_t color) {
+        if (roundness <= 0.0 || rect.width < 1 || rect.height < 1) {
+            fillRectangle(rect, color);
+            return;
+        }
+
+        const auto radius = radiusOf(rect, roundness);
+        const auto [y0, y1] = rows(rect.y, rect.y + rect.height);
+        for (int y = y0; y < y1; ++y)
+            if (auto span = roundedSpan(rect, radius, y + 0.5f))
+                fillSpan(y, span->first, span->second, color);
+    }
+
+    void strokeRectangle(const Rectangle &rect, float thickness, std::uint32_t color) {
+        if (thickness > rect.width || thickness > rect.height) {
+            if (rect.width > rect.height)
+                thickness = rect.height / 2;
+            else if (rect.width < rect.height)
+                thickness = rect.width / 2;
+        }
+
+        fillRectangle(Rectangle{rect.x, rect.y, rect.width, thickness}, color);
+        fillRectangle(Rectangle{rect.x, rect.y + rect.height - thickness, rect.width, thickness}, color);
+        fillRectangle(Rectangle{rect.x, rect.y + thickness, thickness, rect.height - 2 * thickness}, color);
+        fillRectangle(Rectangle{rect.x + rect.width - thickness, rect.y + thickness, thickness, rect.height - 2 * thickness}, color);
+    }
+
+    // Ring outside of `rect`, as raylib does
+    void strokeRoundedRectangle(const Rectangle &rect, float roundness, float thickness, std::uint32_t color) {
+        thickness = std::max(thickness, 0.0f);
+        const Rectangle outer{rect.x - thickness, rect.y - thickness, rect.width + 2 * thickness, rect.height + 2 * thickness};
+        if (roundness <= 0.0) {
+            strokeRectangle(outer, thickness, color);
+            return;
+        }
+
+        const auto radius = radiusOf(rect, roundness);
+        if (radius <= 0.0)
+            return;
+
+        const auto [y0, y1] = rows(outer.y, outer.y + outer.height);
+        for (int y = y0; y < y1; ++y) {
+            const auto outerSpan = roundedSpan(outer, radius + thickness, y + 0.5f);
+            if (!outerSpan)
+                continue;
+
+            if (auto innerSpan = roundedSpan(rect, radius, y + 0.5f)) {
+                fillSpan(y, outerSpan->first, innerSpan->first, color);
+                fillSpan(y, innerSpan->second, outerSpan->second, color);
+            } else
+                fillSpan(y, outerSpan->first, outerSpan->second, color);
+        }
+    }
+
+    void fillConvex(const Vector2 *points, int count, std::uint32_t color) {
+        float minY = INFINITY, maxY = -INFINITY;
+        for (int i = 0; i < count; ++i) {
+            minY = std::min(minY, points[i].y);
+            maxY = std::max(maxY, points[i].y);
+        }
+
+        const auto [y0, y1] = rows(minY, maxY);
+        for (int y = y0; y < y1; ++y)
+            if (auto span = Compositor::ConvexSpan(points, count, y + 0.5f))
+                fillSpan(y, span->first, span->second, color);
+    }
+
+    // raylib `DrawLineEx` quad
+    void drawLine(Vector2 start, Vector2 end, float thickness, std::uint32_t color) {
+        const Vector2 delta{end.x - start.x, end.y - start.y};
+        const auto length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+        if (length <= 0.0 || thickness <= 0.0)
+            return;
+
+        const auto scale = thickness / (2 * length);
+        const Vector2 radius{-scale * delta.y, scale * delta.x};
+        const Vector2 quad[4]{
+            {start.x - radius.x, start.y - radius.y},
+            {end.x - radius.x, end.y - radius.y},
+            {end.x + radius.x, end.y + radius.y},
+            {start.x + radius.x, start.y + radius.y}};
+        fillConvex(quad, 4, color);
+    }
+
+    // Render targets hold layers, they are resampled when transformed
+    void drawTexture(const Surface &texture, const Rectangle &source, const Rectangle &dest, Vector2 origin, float rotation, Color tint) {
+        const auto filter = texture.bottomUp ? Compositor::Filter::Bilinear : Compositor::Filter::Nearest;
+        Compositor::Blit(surface, clip, texture, source, dest, origin, rotation, tint, filter, scratch, kernels);
+    }
+
+    // raylib `DrawTextEx` layout, glyphs are drawn as textures
+    void drawText(const Font &font, const Surface &atlas, const char *text, Vector2 position, float fontSize, float spacing, Color tint) {
+        const auto scale = fontSize / font.baseSize;
+        const auto padding = (float)font.glyphPadding;
+        Vector2 offset{0, 0};
+
+        for (std::size_t i = 0; text[i] != '\0';) {
+            int byteCount = 0;
+            const auto codepoint = GetCodepointNext(text + i, &byteCount);
+            const auto index = GetGlyphIndex(font, codepoint);
+            i += byteCount;
+
+            if (codepoint == '\n') {
+                offset.y += fontSize + TextLineSpacing;
+                offset.x = 0;
+                continue;
+            }
+
+            const auto &glyph = font.glyphs[index];
+            const auto &rec = font.recs[index];
+            if (codepoint != ' ' && codepoint != '\t')
+                drawTexture(atlas,
+                            Rectangle{rec.x - padding, rec.y - padding, rec.width + 2 * padding, rec.height + 2 * padding},
+                            Rectangle{position.x + offset.x + (glyph.offsetX - padding) * scale,
+                                      position.y + offset.y + (glyph.offsetY - padding) * scale,
+                                      (rec.width + 2 * padding) * scale,
+                                      (rec.height + 2 * padding) * scale},
+                            Vector2{0, 0}, 0.0, tint);
+
+            offset.x += (glyph.advanceX == 0 ? rec.width : glyph.advanceX) * scale + spacing;
+        }
+    }
+};
+
+} // namespace
+
+SoftwareBackend::SoftwareBackend(int screenWidth, int screenHeight, std::size_t threadCount)
+    : RecordingBackend(screenWidth, screenHeight), _screen(screenWidth, screenHeight), _target(nullptr) {
+    setThreadCount(threadCount);
+}
+
+SoftwareBackend::~SoftwareBackend() = default;
+
+void SoftwareBackend::setThreadCount(std::size_t threadCount) {
+    _pool = std::make_unique<ThreadPool>(std::max<std::size_t>(threadCount, 1) - 1);
+}
+
+std::size_t SoftwareBackend::getThreadCount() const {
+    return _pool->getThreadCount() + 1;
+}
+
+const Surface &SoftwareBackend::getScreen() const {
+    return _screen;
+}
+
+const Surface *SoftwareBackend::getSurface(const Texture2D &texture) const {
+    auto it = _surfaces.find(texture.id);
+    return it == _surfaces.end() ? nullptr : &it->second;
+}
+
+Surface &SoftwareBackend::getPassSurface() {
+    if (_target)
+        return *_target;
+
+    if (_screen.width != getScreenWidth() || _screen.height != getScreenHeight())
+        _screen = Surface(getScreenWidth(), getScreenHeight());
+    return _screen;
+}
+
+void SoftwareBackend::rasterizePass() {
+    const auto &commands = getCommands();
+    if (commands.empty())
+        return;
+
+    TRACE_ZONE("SoftwareRasterize");
+    auto &surface = getPassSurface();
+    const auto whole = surface.bounds();
+
+    // default font is copied on calling thread, tiles only read it
+    if (!_defaultFont.glyphs && std::ranges::any_of(commands, [&](const auto &command) { return command.type == DrawCommand::Type::Text && !getFont(command); })) {
+        if (!loadDefaultFont() && !_warnedDefaultFont) {
+            TraceLog(LOG_WARNING, "[SoftwareBackend] Default font needs a window, text drawn without font is skipped");
+            _warnedDefaultFont = true;
+        }
+    }
+
+    // bin once so that tiles skip commands not overlapping them
+    _bounds.resize(commands.size());
+    for (std::size_t i = 0; i < commands.size(); ++i) {
+        const auto &command = commands[i];
+        auto &bounds = _bounds[i];
+
+        switch (command.type) {
+        case DrawCommand::Type::Rectangle:
+        case DrawCommand::Type::RoundedRectangle:
+        case DrawCommand::Type::RectangleLines:
+            bounds = boundsOf(command.rect);
+            break;
+        case DrawCommand::Type::RoundedRectangleLines:
+            bounds = boundsOf(command.rect, command.value);
+            break;
+        case DrawCommand::Type::Line: {
+            const auto &[start, end] = command.points;
+            bounds = boundsOf(std::min(start.x, end.x) - command.value, std::min(start.y, end.y) - command.value,
+                              std::max(start.x, end.x) + command.value, std::max(start.y, end.y) + command.value);
+        } break;
+        case DrawCommand::Type::Text: {
+            float fontSize, spacing;
+            const auto font = getTextFont(command, fontSize, spacing);
+            if (font && font != &_defaultFont && !getSurface(font->texture)) {
+                if (!_warnedFontAtlas)
+                    TraceLog(LOG_WARNING, "[SoftwareBackend] Font texture %d was not loaded by this backend, its text is skipped", font->texture.id);
+                _warnedFontAtlas = true;
+                bounds = Box{0, 0, 0, 0};
+            } else if (font) {
+                const auto size = MeasureTextEx(*font, getText(command), fontSize, spacing);
+                const auto padding = font->glyphPadding * fontSize / font->baseSize;
+                bounds = boundsOf(Rectangle{command.points[0].x, command.points[0].y, size.x, size.y}, padding + fontSize);
+            } else
+                bounds = Box{0, 0, 0, 0};
+        } break;
+        case DrawCommand::Type::Texture:
+            if (command.value == 0.0)
+                bounds = boundsOf(Rectangle{command.rect.x - command.points[0].x, command.rect.y - command.points[0].y, command.rect.width, command.rect.height});
+            else {
+                // any rotation stays within circle around rotation center
+                const auto &origin = command.points[0];
+                const auto radius = std::sqrt(std::max(origin.x * origin.x, (command.rect.width - origin.x) * (command.rect.width - origin.x)) +
+                                              std::max(origin.y * origin.y, (command.rect.height - origin.y) * (command.rect.height - origin.y)));
+                bounds = boundsOf(command.rect.x - radius, command.rect.y - radius, command.rect.x + radius, command.rect.y + radius);
+            }
+            break;
+        default:
+            bounds = whole;
+            break;
+        }
+    }
+
+    const int columns = (surface.width + TileSize - 1) / TileSize;
+    const int rows = (surface.height + TileSize - 1) / TileSize;
+    _pool->parallelFor(columns * rows, [&](std::size_t index) {
+        const int x = index % columns * TileSize, y = index / columns * TileSize;
+        rasterizeTile(surface, whole.intersect(Box{x, y, x + TileSize, y + TileSize}));
+    });
+
+    // pass is done, storage is kept
+    clear();
+}
+
+bool SoftwareBackend::loadDefaultFont() {
+    // glyph images are kept by raylib, atlas texture cannot be read without GPU
+    const auto font = GetFontDefault();
+    if (!font.glyphs || !font.recs || font.glyphCount <= 0 || font.texture.width <= 0 || font.texture.height <= 0)
+        return false;
+
+    auto atlas = GenImageColor(font.texture.width, font.texture.height, BLANK);
+    _defaultGlyphs.assign(font.glyphs, font.glyphs + font.glyphCount);
+    _defaultRecs.assign(font.recs, font.recs + font.glyphCount);
+    for (int i = 0; i < font.glyphCount; ++i) {
+        auto &glyph = _defaultGlyphs[i];
+        if (glyph.image.data)
+            ImageDraw(&atlas, glyph.image, Rectangle{0, 0, (float)glyph.image.width, (float)glyph.image.height}, _defaultRecs[i], WHITE);
+        glyph.image = ::Image{};
+    }
+
+    _defaultAtlas = Surface(atlas.width, atlas.height);
+    const bool copied = copyPixels(atlas, _defaultAtlas);
+    UnloadImage(atlas);
+    if (!copied)
+        return false;
+
+    _defaultFont = font;
+    _defaultFont.texture = Texture2D{};
+    _defaultFont.glyphs = _defaultGlyphs.data();
+    _defaultFont.recs = _defaultRecs.data();
+    return true;
+}
+
+const Font *SoftwareBackend::getTextFont(const DrawCommand &command, float &fontSize, float &spacing) const {
+    if (auto font = getFont(command)) {
+        fontSize = command.value;
+        spacing = command.spacing;
+        return font;
+    }
+    if (!_defaultFont.glyphs)
+        return nullptr;
+
+    // raylib `DrawText` clamps size and derives spacing from it
+    const auto size = std::max((int)command.value, DefaultFontSize);
+    fontSize = (float)size;
+    spacing = (float)(size / DefaultFontSize);
+    return &_defaultFont;
+}
+
+void SoftwareBackend::rasterizeTile(Surface &surface, const Box &tile) const {
+    thread_local std::vector<std::uint32_t> scratch;
+    Canvas canvas{surface, tile, SpanKernels::Get(), scratch};
+
+    const auto &commands = getCommands();
+    for (std::size_t i = 0; i < commands.size(); ++i) {
+        const auto &command = commands[i];
+        const auto color = Compositor::Premultiply(command.color);
+
+        if (command.type == DrawCommand::Type::BeginScissor) {
+            // same truncation as raylib `BeginScissorMode`
+            const Box scissor{(int)command.rect.x, (int)command.rect.y,
+                              (int)command.rect.x + (int)command.rect.width, (int)command.rect.y + (int)command.rect.height};
+            canvas.clip = tile.intersect(scissor);
+            continue;
+        }
+        if (command.type == DrawCommand::Type::EndScissor) {
+            canvas.clip = tile;
+            continue;
+        }
+
+        if (canvas.clip.intersect(_bounds[i]).isEmpty())
+            continue;
+
+        switch (command.type) {
+        case DrawCommand::Type::Clear:
+            canvas.clear(color);
+            break;
+        case DrawCommand::Type::Rectangle:
+            canvas.fillRectangle(command.rect, color);
+            break;
+        case DrawCommand::Type::RoundedRectangle:
+            canvas.fillRoundedRectangle(command.rect, command.roundness, color);
+            break;
+        case DrawCommand::Type::RectangleLines:
+            canvas.strokeRectangle(command.rect, command.value, color);
+            break;
+        case DrawCommand::Type::RoundedRectangleLines:
+            canvas.strokeRoundedRectangle(command.rect, command.roundness, command.value, color);
+            break;
+        case DrawCommand::Type::Line:
+            canvas.drawLine(command.points[0], command.points[1], command.value, color);
+            break;
+        case DrawCommand::Type::Text: {
+            float fontSize, spacing;
+            const auto font = getTextFont(command, fontSize, spacing);
+            const auto atlas = font == &_defaultFont ? &_defaultAtlas : font ? getSurface(font->texture) : nullptr;
+            if (atlas)
+                canvas.drawText(*font, *atlas, getText(command), command.points[0], fontSize, spacing, command.color);
+        } break;
+        case DrawCommand::Type::Texture:
+            if (auto texture = getSurface(command.texture))
+                canvas.drawTexture(*texture, command.source, command.rect, command.points[0], command.value, command.color);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void SoftwareBackend::onBeginFrame() {
+    rasterizePass();
+}
+
+void SoftwareBackend::onEndFrame() {
+    rasterizePass();
+}
+
+RenderTexture2D SoftwareBackend::onLoadRenderTarget(int width, int height) {
+    auto target = RecordingBackend::onLoadRenderTarget(width, height);
+    _surfaces.emplace(target.texture.id, Surface(width, height, true));
+    return target;
+}
+
+void SoftwareBackend::onUnloadRenderTarget(const RenderTexture2D &target) {
+    if (_target == getSurface(target.texture))
+        _target = nullptr;
+    _surfaces.erase(target.texture.id);
+}
+
+void SoftwareBackend::onBeginRenderTarget(const RenderTexture2D &target) {
+    // screen commands recorded so far go below whatever this target is composited into
+    rasterizePass();
+
+    auto it = _surfaces.find(target.texture.id);
+    _target = it == _surfaces.end() ? nullptr : &it->second;
+    if (!_target)
+        TraceLog(LOG_WARNING, "[SoftwareBackend] Render target %d was not loaded by this backend", target.id);
+}
+
+void SoftwareBackend::onEndRenderTarget() {
+    rasterizePass();
+    _target = nullptr;
+}
+
+Texture2D SoftwareBackend::onLoadTexture(const ::Image &image) {
+    auto texture = RecordingBackend::onLoadTexture(image);
+    auto &surface = _surfaces.emplace(texture.id, Surface(image.width, image.height)).first->second;
+
+    if (!copyPixels(image, surface))
+        TraceLog(LOG_WARNING, "[SoftwareBackend] Unsupported pixel format %d, texture %d left blank", image.format, texture.id);
+
+    texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return texture;
+}
+
+void SoftwareBackend::onUnloadTexture(const Texture2D &texture) {
+    _surfaces.erase(texture.id);
+}
+
+bool SoftwareBackend::onReadPixels(const RenderTexture2D &target, std::vector<Color> &pixels) {
+    const auto surface = getSurface(target.texture);
+    if (!surface)
+        return false;
+
+    pixels.resize(surface->pixels.size());
+    for (int y = 0; y < surface->height; ++y) {
+        const auto scanline = surface->scanline(y);
+        auto row = pixels.data() + std::size_t(y) * surface->width;
+        for (int x = 0; x < surface->width; ++x)
+            row[x] = Compositor::Unpremultiply(scanline[x]);
+    }
+    return true;
+}
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
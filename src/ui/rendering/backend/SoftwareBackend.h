@@ -0,0 +1,83 @@
+#pragma once
+
+#include "./RecordingBackend.h"
+#include "./Surface.h"
+
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class ThreadPool;
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+/**
+ * Rasterizes on CPU, needs neither window nor GPU (thumbnails, CI).
+ * Commands are recorded then rasterized once their pass ends (render target end or frame end) :
+ * target is split in tiles rasterized in parallel, each tile replays commands overlapping it.
+ * Shapes are aliased and textures sampled with nearest filter, like raylib defaults,
+ * layers are resampled with bilinear filter when transformed. Surfaces hold premultiplied alpha.
+ * Text without font uses raylib default font, whose glyphs only exist once a window is open :
+ * it is rasterized from a copy of them, and skipped with a warning while headless.
+ */
+class SoftwareBackend : public RecordingBackend {
+  public:
+    static constexpr int TileSize = 64;
+
+  private:
+    std::unordered_map<unsigned int, Surface> _surfaces; // by texture id
+    Surface _screen;
+    Surface *_target; // `nullptr` while drawing to screen
+    std::vector<Box> _bounds;
+    std::unique_ptr<ThreadPool> _pool;
+
+    // Copy of raylib default font, survives window closing
+    Font _defaultFont{};
+    std::vector<GlyphInfo> _defaultGlyphs;
+    std::vector<Rectangle> _defaultRecs;
+    Surface _defaultAtlas;
+    bool _warnedDefaultFont = false;
+    bool _warnedFontAtlas = false;
+
+    bool loadDefaultFont();
+    // Font, size and spacing text command is drawn with, `nullptr` font when it cannot be drawn
+    const Font *getTextFont(const DrawCommand &command, float &fontSize, float &spacing) const;
+    Surface &getPassSurface();
+    void rasterizePass();
+    void rasterizeTile(Surface &surface, const Box &tile) const;
+
+  protected:
+    void onBeginFrame() override;
+    void onEndFrame() override;
+
+    RenderTexture2D onLoadRenderTarget(int width, int height) override;
+    void onUnloadRenderTarget(const RenderTexture2D &target) override;
+    void onBeginRenderTarget(const RenderTexture2D &target) override;
+    void onEndRenderTarget() override;
+
+    Texture2D onLoadTexture(const ::Image &image) override;
+    void onUnloadTexture(const Texture2D &texture) override;
+
+    bool onReadPixels(const RenderTexture2D &target, std::vector<Color> &pixels) override;
+
+  public:
+    // @param threadCount Threads rasterizing tiles, calling thread included
+    SoftwareBackend(int screenWidth, int screenHeight, std::size_t threadCount = std::thread::hardware_concurrency());
+    ~SoftwareBackend();
+
+    void setThreadCount(std::size_t threadCount);
+    std::size_t getThreadCount() const;
+
+    // Frame buffer with premultiplied alpha, written when frame ends
+    const Surface &getScreen() const;
+
+    // Pixels of a texture or render target texture, `nullptr` if not loaded by this backend
+    const Surface *getSurface(const Texture2D &texture) const;
+};
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
@@ -0,0 +1,392 @@
+#include "./SpanKernels.h"
+
+#include <algorithm>
+
+// SSE2 is part of x86-64 baseline, SSE4.1 and AVX2 functions are compiled for their own target only
+#if defined(__GNUC__) && defined(__x86_64__)
+#define UI_SPAN_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+namespace {
+
+// Exact round(x / 255) for x in [0; 255 * 255]
+inline std::uint32_t div255(std::uint32_t x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+inline std::uint32_t overPixel(std::uint32_t src, std::uint32_t dst) {
+    const auto inverse = 255 - (src >> 24);
+    if (inverse == 0)
+        return src;
+    if (src == 0)
+        return dst;
+
+    std::uint32_t out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+        out |= std::min(255u, ((src >> shift) & 0xff) + div255(((dst >> shift) & 0xff) * inverse)) << shift;
+    return out;
+}
+
+inline std::uint32_t modulatePixel(std::uint32_t pixel, std::uint32_t tint) {
+    std::uint32_t out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+        out |= div255(((pixel >> shift) & 0xff) * ((tint >> shift) & 0xff)) << shift;
+    return out;
+}
+
+inline std::uint32_t premultiplyPixel(std::uint32_t pixel) {
+    const auto alpha = pixel >> 24;
+    return modulatePixel(pixel, alpha * 0x010101 | 0xff000000);
+}
+
+// Bilinear weights precision, products of two weights and a channel still fit in 32 bits unsigned
+constexpr int WeightBits = 12;
+constexpr std::uint32_t WeightOne = 1 << WeightBits;
+
+struct Axis {
+    int i0, i1;
+    std::uint32_t weight; // of i1, over `WeightOne`
+};
+
+// Neighbour texels of 16.16 fixed point coordinate
+inline Axis axisOf(std::int32_t position, int size) {
+    const auto i = position >> 16; // arithmetic shift, floor for negative positions
+    return Axis{std::clamp(i, 0, size - 1), std::clamp(i + 1, 0, size - 1), std::uint32_t(position >> (16 - WeightBits)) & (WeightOne - 1)};
+}
+
+// Weights sum to `WeightOne` squared, result is within half a unit of exact interpolation
+inline std::uint32_t bilinearPixel(std::uint32_t p00, std::uint32_t p10, std::uint32_t p01, std::uint32_t p11, std::uint32_t fx, std::uint32_t fy) {
+    const auto w00 = (WeightOne - fx) * (WeightOne - fy), w10 = fx * (WeightOne - fy), w01 = (WeightOne - fx) * fy, w11 = fx * fy;
+
+    constexpr std::uint32_t Half = 1 << (2 * WeightBits - 1);
+    std::uint32_t out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        const auto sum = ((p00 >> shift) & 0xff) * w00 + ((p10 >> shift) & 0xff) * w10 +
+                         ((p01 >> shift) & 0xff) * w01 + ((p11 >> shift) & 0xff) * w11;
+        out |= ((sum + Half) >> (2 * WeightBits)) << shift;
+    }
+    return out;
+}
+
+void scalarFill(std::uint32_t *dst, std::size_t count, std::uint32_t color) {
+    if ((color >> 24) == 255) {
+        std::fill_n(dst, count, color);
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = overPixel(color, dst[i]);
+}
+
+void scalarBlend(std::uint32_t *dst, const std::uint32_t *src, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = overPixel(src[i], dst[i]);
+}
+
+void scalarModulate(std::uint32_t *pixels, std::size_t count, std::uint32_t tint) {
+    if (tint == 0xffffffff)
+        return;
+
+    for (std::size_t i = 0; i < count; ++i)
+        pixels[i] = modulatePixel(pixels[i], tint);
+}
+
+void scalarPremultiply(std::uint32_t *pixels, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+        pixels[i] = premultiplyPixel(pixels[i]);
+}
+
+void scalarSampleBilinear(std::uint32_t *dst, std::size_t count, const Surface &src,
+                          std::int32_t x, std::int32_t y, std::int32_t dx, std::int32_t dy) {
+    for (std::size_t i = 0; i < count; ++i, x += dx, y += dy) {
+        const auto ax = axisOf(x, src.width), ay = axisOf(y, src.height);
+        const auto *row0 = src.row(ay.i0), *row1 = src.row(ay.i1);
+        dst[i] = bilinearPixel(row0[ax.i0], row0[ax.i1], row1[ax.i0], row1[ax.i1], ax.weight, ay.weight);
+    }
+}
+
+#ifdef UI_SPAN_KERNELS_X86
+
+// 16 bits lanes hold one channel each, 4 pixels per register
+
+inline __m128i div255x8(__m128i x) {
+    const auto t = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+inline __m128i broadcastAlphax8(__m128i channels) {
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(channels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+inline __m128i overHalfx8(__m128i src, __m128i dst) {
+    const auto inverse = _mm_sub_epi16(_mm_set1_epi16(255), broadcastAlphax8(src));
+    return _mm_add_epi16(src, div255x8(_mm_mullo_epi16(dst, inverse)));
+}
+
+inline __m128i overx4(__m128i src, __m128i dst) {
+    const auto zero = _mm_setzero_si128();
+    const auto lo = overHalfx8(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero));
+    const auto hi = overHalfx8(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero));
+    return _mm_packus_epi16(lo, hi);
+}
+
+inline __m128i modulatex4(__m128i pixels, __m128i tint16) {
+    const auto zero = _mm_setzero_si128();
+    const auto lo = div255x8(_mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), tint16));
+    const auto hi = div255x8(_mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), tint16));
+    return _mm_packus_epi16(lo, hi);
+}
+
+// (a, a, a, 255) for every pixel so that alpha channel is kept
+inline __m128i premultiplierx8(__m128i channels) {
+    const auto colorLanes = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const auto alphaLanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    return _mm_or_si128(_mm_and_si128(broadcastAlphax8(channels), colorLanes), alphaLanes);
+}
+
+void sse2Fill(std::uint32_t *dst, std::size_t count, std::uint32_t color) {
+    if ((color >> 24) == 255) {
+        std::fill_n(dst, count, color);
+        return;
+    }
+
+    const auto src = _mm_set1_epi32(color);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto *p = reinterpret_cast<__m128i *>(dst + i);
+        _mm_storeu_si128(p, overx4(src, _mm_loadu_si128(p)));
+    }
+    scalarFill(dst + i, count - i, color);
+}
+
+void sse2Blend(std::uint32_t *dst, const std::uint32_t *src, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto *p = reinterpret_cast<__m128i *>(dst + i);
+        const auto s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_si128(p, overx4(s, _mm_loadu_si128(p)));
+    }
+    scalarBlend(dst + i, src + i, count - i);
+}
+
+void sse2Modulate(std::uint32_t *pixels, std::size_t count, std::uint32_t tint) {
+    if (tint == 0xffffffff)
+        return;
+
+    const auto tint16 = _mm_unpacklo_epi8(_mm_set1_epi32(tint), _mm_setzero_si128());
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto *p = reinterpret_cast<__m128i *>(pixels + i);
+        _mm_storeu_si128(p, modulatex4(_mm_loadu_si128(p), tint16));
+    }
+    scalarModulate(pixels + i, count - i, tint);
+}
+
+void sse2Premultiply(std::uint32_t *pixels, std::size_t count) {
+    const auto zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto *p = reinterpret_cast<__m128i *>(pixels + i);
+        const auto value = _mm_loadu_si128(p);
+        const auto lo = _mm_unpacklo_epi8(value, zero), hi = _mm_unpackhi_epi8(value, zero);
+        _mm_storeu_si128(p, _mm_packus_epi16(div255x8(_mm_mullo_epi16(lo, premultiplierx8(lo))),
+                                             div255x8(_mm_mullo_epi16(hi, premultiplierx8(hi)))));
+    }
+    scalarPremultiply(pixels + i, count - i);
+}
+
+// One pixel per register, 32 bits per channel
+
+#define UI_TARGET_SSE41 __attribute__((target("sse4.1")))
+
+UI_TARGET_SSE41 inline __m128i widenx4(std::uint32_t pixel) {
+    return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(pixel));
+}
+
+UI_TARGET_SSE41 void sse41SampleBilinear(std::uint32_t *dst, std::size_t count, const Surface &src,
+                                         std::int32_t x, std::int32_t y, std::int32_t dx, std::int32_t dy) {
+    const auto half = _mm_set1_epi32(1 << (2 * WeightBits - 1));
+    for (std::size_t i = 0; i < count; ++i, x += dx, y += dy) {
+        const auto ax = axisOf(x, src.width), ay = axisOf(y, src.height);
+        const auto *row0 = src.row(ay.i0), *row1 = src.row(ay.i1);
+        const auto fx = ax.weight, fy = ay.weight;
+
+        auto sum = _mm_add_epi32(_mm_mullo_epi32(widenx4(row0[ax.i0]), _mm_set1_epi32((WeightOne - fx) * (WeightOne - fy))),
+                                 _mm_mullo_epi32(widenx4(row0[ax.i1]), _mm_set1_epi32(fx * (WeightOne - fy))));
+        sum = _mm_add_epi32(sum, _mm_mullo_epi32(widenx4(row1[ax.i0]), _mm_set1_epi32((WeightOne - fx) * fy)));
+        sum = _mm_add_epi32(sum, _mm_mullo_epi32(widenx4(row1[ax.i1]), _mm_set1_epi32(fx * fy)));
+
+        const auto channels = _mm_srli_epi32(_mm_add_epi32(sum, half), 2 * WeightBits);
+        const auto packed = _mm_packus_epi16(_mm_packus_epi32(channels, channels), _mm_setzero_si128());
+        dst[i] = _mm_cvtsi128_si32(packed);
+    }
+}
+
+#undef UI_TARGET_SSE41
+
+// 8 pixels per register, unpack and pack stay within 128 bits lanes so order is kept
+
+#define UI_TARGET_AVX2 __attribute__((target("avx2")))
+
+UI_TARGET_AVX2 inline __m256i div255x16(__m256i x) {
+    const auto t = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+UI_TARGET_AVX2 inline __m256i broadcastAlphax16(__m256i channels) {
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(channels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+UI_TARGET_AVX2 inline __m256i overHalfx16(__m256i src, __m256i dst) {
+    const auto inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), broadcastAlphax16(src));
+    return _mm256_add_epi16(src, div255x16(_mm256_mullo_epi16(dst, inverse)));
+}
+
+UI_TARGET_AVX2 inline __m256i overx8(__m256i src, __m256i dst) {
+    const auto zero = _mm256_setzero_si256();
+    const auto lo = overHalfx16(_mm256_unpacklo_epi8(src, zero), _mm256_unpacklo_epi8(dst, zero));
+    const auto hi = overHalfx16(_mm256_unpackhi_epi8(src, zero), _mm256_unpackhi_epi8(dst, zero));
+    return _mm256_packus_epi16(lo, hi);
+}
+
+UI_TARGET_AVX2 inline __m256i premultiplierx16(__m256i channels) {
+    const auto colorLanes = _mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1);
+    const auto alphaLanes = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+    return _mm256_or_si256(_mm256_and_si256(broadcastAlphax16(channels), colorLanes), alphaLanes);
+}
+
+UI_TARGET_AVX2 void avx2Fill(std::uint32_t *dst, std::size_t count, std::uint32_t color) {
+    if ((color >> 24) == 255) {
+        std::fill_n(dst, count, color);
+        return;
+    }
+
+    const auto src = _mm256_set1_epi32(color);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto *p = reinterpret_cast<__m256i *>(dst + i);
+        _mm256_storeu_si256(p, overx8(src, _mm256_loadu_si256(p)));
+    }
+    sse2Fill(dst + i, count - i, color);
+}
+
+UI_TARGET_AVX2 void avx2Blend(std::uint32_t *dst, const std::uint32_t *src, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto *p = reinterpret_cast<__m256i *>(dst + i);
+        const auto s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        _mm256_storeu_si256(p, overx8(s, _mm256_loadu_si256(p)));
+    }
+    sse2Blend(dst + i, src + i, count - i);
+}
+
+UI_TARGET_AVX2 void avx2Modulate(std::uint32_t *pixels, std::size_t count, std::uint32_t tint) {
+    if (tint == 0xffffffff)
+        return;
+
+    const auto zero = _mm256_setzero_si256();
+    const auto tint16 = _mm256_unpacklo_epi8(_mm256_set1_epi32(tint), zero);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto *p = reinterpret_cast<__m256i *>(pixels + i);
+        const auto value = _mm256_loadu_si256(p);
+        const auto lo = div255x16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(value, zero), tint16));
+        const auto hi = div255x16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(value, zero), tint16));
+        _mm256_storeu_si256(p, _mm256_packus_epi16(lo, hi));
+    }
+    sse2Modulate(pixels + i, count - i, tint);
+}
+
+UI_TARGET_AVX2 void avx2Premultiply(std::uint32_t *pixels, std::size_t count) {
+    const auto zero = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto *p = reinterpret_cast<__m256i *>(pixels + i);
+        const auto value = _mm256_loadu_si256(p);
+        const auto lo = _mm256_unpacklo_epi8(value, zero), hi = _mm256_unpackhi_epi8(value, zero);
+        _mm256_storeu_si256(p, _mm256_packus_epi16(div255x16(_mm256_mullo_epi16(lo, premultiplierx16(lo))),
+                                                   div255x16(_mm256_mullo_epi16(hi, premultiplierx16(hi)))));
+    }
+    sse2Premultiply(pixels + i, count - i);
+}
+
+UI_TARGET_AVX2 inline __m256i widenx8(std::uint32_t a, std::uint32_t b) {
+    return _mm256_cvtepu8_epi32(_mm_set_epi32(0, 0, b, a));
+}
+
+UI_TARGET_AVX2 inline __m256i weightsx8(std::uint32_t a, std::uint32_t b) {
+    return _mm256_set_m128i(_mm_set1_epi32(b), _mm_set1_epi32(a));
+}
+
+// Two samples per register, one per 128 bits lane
+UI_TARGET_AVX2 void avx2SampleBilinear(std::uint32_t *dst, std::size_t count, const Surface &src,
+                                       std::int32_t x, std::int32_t y, std::int32_t dx, std::int32_t dy) {
+    const auto half = _mm256_set1_epi32(1 << (2 * WeightBits - 1));
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2, x += 2 * dx, y += 2 * dy) {
+        const auto axA = axisOf(x, src.width), ayA = axisOf(y, src.height);
+        const auto axB = axisOf(x + dx, src.width), ayB = axisOf(y + dy, src.height);
+        const auto *a0 = src.row(ayA.i0), *a1 = src.row(ayA.i1);
+        const auto *b0 = src.row(ayB.i0), *b1 = src.row(ayB.i1);
+        const auto fxA = axA.weight, fyA = ayA.weight, fxB = axB.weight, fyB = ayB.weight;
+
+        auto sum = _mm256_mullo_epi32(widenx8(a0[axA.i0], b0[axB.i0]), weightsx8((WeightOne - fxA) * (WeightOne - fyA), (WeightOne - fxB) * (WeightOne - fyB)));
+        sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(widenx8(a0[axA.i1], b0[axB.i1]), weightsx8(fxA * (WeightOne - fyA), fxB * (WeightOne - fyB))));
+        sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(widenx8(a1[axA.i0], b1[axB.i0]), weightsx8((WeightOne - fxA) * fyA, (WeightOne - fxB) * fyB)));
+        sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(widenx8(a1[axA.i1], b1[axB.i1]), weightsx8(fxA * fyA, fxB * fyB)));
+
+        const auto channels = _mm256_srli_epi32(_mm256_add_epi32(sum, half), 2 * WeightBits);
+        const auto packed = _mm256_packus_epi16(_mm256_packus_epi32(channels, channels), _mm256_setzero_si256());
+        dst[i] = _mm_cvtsi128_si32(_mm256_castsi256_si128(packed));
+        dst[i + 1] = _mm_cvtsi128_si32(_mm256_extracti128_si256(packed, 1));
+    }
+    scalarSampleBilinear(dst + i, count - i, src, x, y, dx, dy);
+}
+
+#undef UI_TARGET_AVX2
+
+#endif
+
+const SpanKernels scalarKernels{"scalar", scalarFill, scalarBlend, scalarModulate, scalarPremultiply, scalarSampleBilinear};
+
+std::vector<const SpanKernels *> supportedKernels() {
+    std::vector<const SpanKernels *> kernels{&scalarKernels};
+#ifdef UI_SPAN_KERNELS_X86
+    static const SpanKernels sse2{"sse2", sse2Fill, sse2Blend, sse2Modulate, sse2Premultiply, scalarSampleBilinear};
+    static const SpanKernels sse41{"sse4.1", sse2Fill, sse2Blend, sse2Modulate, sse2Premultiply, sse41SampleBilinear};
+    static const SpanKernels avx2{"avx2", avx2Fill, avx2Blend, avx2Modulate, avx2Premultiply, avx2SampleBilinear};
+
+    __builtin_cpu_init();
+    kernels.push_back(&sse2);
+    if (__builtin_cpu_supports("sse4.1"))
+        kernels.push_back(&sse41);
+    if (__builtin_cpu_supports("avx2"))
+        kernels.push_back(&avx2);
+#endif
+    return kernels;
+}
+
+} // namespace
+
+const SpanKernels &SpanKernels::Get() {
+    return *Supported().back();
+}
+
+const std::vector<const SpanKernels *> &SpanKernels::Supported() {
+    static const auto kernels = supportedKernels();
+    return kernels;
+}
+
+const SpanKernels &SpanKernels::Scalar() {
+    return scalarKernels;
+}
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "./Surface.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+/**
+ * Pixel span routines of the software rasterizer, pixels are packed premultiplied `Color`.
+ * Implementation is picked once at runtime : AVX2, SSE4.1, SSE2 or scalar.
+ * Every implementation gives the same result as `Scalar()`, bit for bit.
+ */
+struct SpanKernels {
+    const char *name;
+
+    // `color` over `count` pixels : dst = color + dst * (255 - color.a) / 255
+    void (*fill)(std::uint32_t *dst, std::size_t count, std::uint32_t color);
+
+    // `src[i]` over `dst[i]`
+    void (*blend)(std::uint32_t *dst, const std::uint32_t *src, std::size_t count);
+
+    // Multiplies every channel by premultiplied `tint`, opacity being a grey tint
+    void (*modulate)(std::uint32_t *pixels, std::size_t count, std::uint32_t tint);
+
+    // Straight to premultiplied alpha
+    void (*premultiply)(std::uint32_t *pixels, std::size_t count);
+
+    // `count` samples of `src` starting at (x; y), moving by (dx; dy) every sample.
+    // Texel coordinates in 16.16 fixed point, texel centers being on integers, edges are clamped.
+    void (*sampleBilinear)(std::uint32_t *dst, std::size_t count, const Surface &src,
+                           std::int32_t x, std::int32_t y, std::int32_t dx, std::int32_t dy);
+
+    // Best implementation supported by running CPU
+    static const SpanKernels &Get();
+
+    // Portable fallback, also used as reference
+    static const SpanKernels &Scalar();
+
+    // Every implementation running CPU supports, from scalar to best
+    static const std::vector<const SpanKernels *> &Supported();
+};
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+// Integer pixel area, max bounds excluded
+struct Box {
+    int x0, y0, x1, y1;
+
+    bool isEmpty() const { return x0 >= x1 || y0 >= y1; }
+
+    Box intersect(const Box &other) const {
+        return Box{std::max(x0, other.x0), std::max(y0, other.y0), std::min(x1, other.x1), std::min(y1, other.y1)};
+    }
+};
+
+/**
+ * CPU pixel buffer, 32 bits RGBA (same memory layout as raylib `Color`) with premultiplied alpha.
+ * Render targets are stored bottom-up like OpenGL ones so that sources with negative height
+ * (raylib idiom to draw a render texture upright) sample them the same way on every backend.
+ */
+struct Surface {
+    int width = 0;
+    int height = 0;
+    bool bottomUp = false;
+    std::vector<std::uint32_t> pixels;
+
+    Surface() = default;
+    Surface(int width, int height, bool bottomUp = false)
+        : width(width), height(height), bottomUp(bottomUp), pixels(std::size_t(width) * height, 0) {}
+
+    // Storage order
+    std::uint32_t *row(int y) { return pixels.data() + std::size_t(y) * width; }
+    const std::uint32_t *row(int y) const { return pixels.data() + std::size_t(y) * width; }
+
+    // Drawing order, y axis goes down whatever storage
+    std::uint32_t *scanline(int y) { return row(bottomUp ? height - 1 - y : y); }
+    const std::uint32_t *scanline(int y) const { return row(bottomUp ? height - 1 - y : y); }
+
+    Box bounds() const { return Box{0, 0, width, height}; }
+
+    static std::uint32_t Pack(Color color) { return std::bit_cast<std::uint32_t>(color); }
+    static Color Unpack(std::uint32_t pixel) { return std::bit_cast<Color>(pixel); }
+};
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
@@ -0,0 +1,156 @@
+#include "./ThreadedBackend.h"
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+ThreadedBackend::ThreadedBackend(std::unique_ptr<DrawBackend> target)
+    : RecordingBackend(0, 0), _target(std::move(target)), _renderThread(std::this_thread::get_id()),
+      _commitPending(false), _presented(false), _screenWidth(0), _screenHeight(0) {}
+
+ThreadedBackend::~ThreadedBackend() {
+    runTasks();
+    for (const auto &font : _retiredFonts)
+        _target->unloadFont(font);
+}
+
+bool ThreadedBackend::isRenderThread() const {
+    return std::this_thread::get_id() == _renderThread;
+}
+
+void ThreadedBackend::refreshScreenSize() {
+    _screenWidth = _target->getScreenWidth();
+    _screenHeight = _target->getScreenHeight();
+}
+
+bool ThreadedBackend::needsWindow() const {
+    return _target->needsWindow();
+}
+
+int ThreadedBackend::getScreenWidth() const {
+    return isRenderThread() ? _target->getScreenWidth() : _screenWidth.load();
+}
+
+int ThreadedBackend::getScreenHeight() const {
+    return isRenderThread() ? _target->getScreenHeight() : _screenHeight.load();
+}
+
+void ThreadedBackend::setScreenSize(int width, int height) {
+    _screenWidth = width;
+    _screenHeight = height;
+    post([this, width, height] { _target->setScreenSize(width, height); });
+}
+
+Vector2 ThreadedBackend::measureText(const Font *font, const char *text, float fontSize, float spacing) const {
+    // CPU only, font data is never modified once loaded
+    return _target->measureText(font, text, fontSize, spacing);
+}
+
+void ThreadedBackend::post(std::function<void()> task) {
+    if (isRenderThread()) {
+        runTasks();
+        task();
+    } else
+        _tasks.push(std::move(task));
+}
+
+void ThreadedBackend::onEndFrame() {
+    commit(false);
+}
+
+void ThreadedBackend::onEndOffscreenPass() {
+    commit(true);
+}
+
+void ThreadedBackend::commit(bool offscreen) {
+    std::vector<Font> retired;
+    {
+        std::unique_lock lock(_commitMutex);
+        // previous list is recycled once replayed
+        _commitCondition.wait(lock, [this] { return !_commitPending; });
+        std::swap(_commands, _committed);
+        _commitPending = true;
+        retired.swap(_retiredFonts);
+    }
+    post([this, offscreen] { present(offscreen); });
+
+    // committed list may still reference them
+    if (!retired.empty())
+        post([this, retired = std::move(retired)] {
+            for (const auto &font : retired)
+                _target->unloadFont(font);
+        });
+}
+
+void ThreadedBackend::present(bool offscreen) {
+    if (offscreen) {
+        _target->beginOffscreenPass();
+        _target->submit(_committed);
+        _target->endOffscreenPass();
+    } else {
+        _target->beginFrame();
+        _target->submit(_committed);
+        _target->endFrame();
+    }
+    refreshScreenSize();
+
+    {
+        std::lock_guard lock(_commitMutex);
+        _commitPending = false;
+    }
+    _commitCondition.notify_one();
+    _presented |= !offscreen;
+}
+
+bool ThreadedBackend::processTasks(std::chrono::milliseconds timeout) {
+    refreshScreenSize();
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    _presented = false;
+    while (!_presented) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+            break;
+
+        auto task = _tasks.waitPop(deadline - now);
+        if (!task)
+            break;
+        (*task)();
+    }
+    return _presented;
+}
+
+void ThreadedBackend::runTasks() {
+    refreshScreenSize();
+    while (auto task = _tasks.tryPop())
+        (*task)();
+}
+
+RenderTexture2D ThreadedBackend::onLoadRenderTarget(int width, int height) {
+    return call([&] { return _target->loadRenderTarget(width, height); });
+}
+
+void ThreadedBackend::onUnloadRenderTarget(const RenderTexture2D &target) {
+    post([this, target] { _target->unloadRenderTarget(target); });
+}
+
+Texture2D ThreadedBackend::onLoadTexture(const ::Image &image) {
+    return call([&] { return _target->loadTexture(image); });
+}
+
+void ThreadedBackend::onUnloadTexture(const Texture2D &texture) {
+    post([this, texture] { _target->unloadTexture(texture); });
+}
+
+void ThreadedBackend::onUnloadFont(const Font &font) {
+    std::lock_guard lock(_commitMutex);
+    _retiredFonts.push_back(font);
+}
+
+bool ThreadedBackend::onReadPixels(const RenderTexture2D &target, std::vector<Color> &pixels) {
+    return call([&] { return _target->readPixels(target, pixels); });
+}
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
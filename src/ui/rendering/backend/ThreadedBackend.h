@@ -0,0 +1,106 @@
+#pragma once
+
+#include "../../../core/ThreadSafeQueue.h"
+#include "./RecordingBackend.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ui {
+namespace rendering {
+namespace backend {
+
+/**
+ * Splits painting from submission : the UI thread records every frame into a command list,
+ * committed when the frame ends, while the render thread replays the previously committed one
+ * into the wrapped backend. Two lists are recycled (double buffering) : committing waits until
+ * the render thread is done with the previous list, so at most one frame is in flight.
+ * Resources are loaded on the render thread, the UI thread waiting for the result,
+ * and unloaded after every frame committed before, which may still draw them.
+ * Fonts are only unloaded once the frame being recorded has been replayed too,
+ * since recorded text commands keep a copy of their glyph pointers.
+ * The render thread is the one constructing this backend, it must own the graphics context.
+ */
+class ThreadedBackend : public RecordingBackend {
+    std::unique_ptr<DrawBackend> _target;
+    std::thread::id _renderThread;
+    ThreadSafeQueue<std::function<void()>> _tasks; // run in order by render thread
+
+    CommandList _committed; // being replayed, or waiting to be
+    std::mutex _commitMutex;
+    std::condition_variable _commitCondition;
+    bool _commitPending;
+    bool _presented; // render thread only
+    std::vector<Font> _retiredFonts; // guarded by `_commitMutex`, unloaded after next commit
+
+    std::atomic<int> _screenWidth;
+    std::atomic<int> _screenHeight;
+
+    bool isRenderThread() const;
+    void refreshScreenSize();
+
+    // Swaps recorded list for replay, `offscreen` ones are replayed without presenting
+    void commit(bool offscreen);
+
+    // Render thread : replays committed list
+    void present(bool offscreen);
+
+    // Runs `task` on render thread after queued ones, without waiting
+    void post(std::function<void()> task);
+
+    // Runs `task` on render thread after queued ones and waits for its result
+    template <typename F>
+    auto call(F task) -> decltype(task()) {
+        if (isRenderThread()) {
+            runTasks();
+            return task();
+        }
+
+        std::packaged_task<decltype(task())()> packaged(std::move(task));
+        auto result = packaged.get_future();
+        _tasks.push([&packaged] { packaged(); });
+        return result.get();
+    }
+
+  protected:
+    void onEndFrame() override;
+    void onEndOffscreenPass() override;
+
+    RenderTexture2D onLoadRenderTarget(int width, int height) override;
+    void onUnloadRenderTarget(const RenderTexture2D &target) override;
+
+    Texture2D onLoadTexture(const ::Image &image) override;
+    void onUnloadTexture(const Texture2D &texture) override;
+    void onUnloadFont(const Font &font) override;
+
+    bool onReadPixels(const RenderTexture2D &target, std::vector<Color> &pixels) override;
+
+  public:
+    ThreadedBackend(std::unique_ptr<DrawBackend> target);
+    ~ThreadedBackend();
+
+    bool needsWindow() const override;
+    int getScreenWidth() const override;
+    int getScreenHeight() const override;
+    void setScreenSize(int width, int height) override;
+
+    Vector2 measureText(const Font *font, const char *text, float fontSize, float spacing) const override;
+
+    // Render thread : runs queued resource operations and frames until a frame has been presented
+    // or `timeout` expired, returns `true` in the former case
+    bool processTasks(std::chrono::milliseconds timeout);
+
+    // Render thread : runs every queued task without waiting
+    void runTasks();
+};
+
+} // namespace backend
+} // namespace rendering
+} // namespace ui
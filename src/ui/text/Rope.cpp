@@ -0,0 +1,281 @@
+#include "./Rope.h"
+
+#include <algorithm>
+
+namespace ui {
+namespace text {
+
+Rope::Node::Node(std::string_view text, std::uint32_t priority)
+    : chunk(text), priority(priority) {
+    recountChunk();
+    update();
+}
+
+void Rope::Node::recountChunk() {
+    chunkNewlines = std::count(chunk.begin(), chunk.end(), '\n');
+}
+
+void Rope::Node::update() {
+    bytes = chunk.size() + BytesOf(left) + BytesOf(right);
+    newlines = chunkNewlines + NewlinesOf(left) + NewlinesOf(right);
+}
+
+Rope::Rope() : _rng(0x5eed) {}
+
+Rope::Rope(std::string_view text) : Rope() {
+    assign(text);
+}
+
+Rope::Size Rope::BytesOf(const NodePtr &node) {
+    return node ? node->bytes : 0;
+}
+
+Rope::Size Rope::NewlinesOf(const NodePtr &node) {
+    return node ? node->newlines : 0;
+}
+
+Rope::NodePtr Rope::makeNode(std::string_view text) {
+    return std::make_unique<Node>(text, _rng());
+}
+
+Rope::NodePtr Rope::build(std::string_view text) {
+    NodePtr subtree;
+    for (Size offset = 0; offset < text.size(); offset += ChunkSize)
+        subtree = merge(std::move(subtree), makeNode(text.substr(offset, ChunkSize)));
+    return subtree;
+}
+
+std::pair<Rope::NodePtr, Rope::NodePtr> Rope::split(NodePtr node, Size pos) {
+    if (!node)
+        return {nullptr, nullptr};
+
+    const auto leftBytes = BytesOf(node->left);
+    const auto chunkEnd = leftBytes + node->chunk.size();
+
+    if (pos <= leftBytes) {
+        auto [left, right] = split(std::move(node->left), pos);
+        node->left = std::move(right);
+        node->update();
+        return {std::move(left), std::move(node)};
+    }
+
+    if (pos >= chunkEnd) {
+        auto [left, right] = split(std::move(node->right), pos - chunkEnd);
+        node->right = std::move(left);
+        node->update();
+        return {std::move(node), std::move(right)};
+    }
+
+    // cut through this node's chunk
+    const auto offset = pos - leftBytes;
+    auto tail = makeNode(std::string_view(node->chunk).substr(offset));
+    node->chunk.resize(offset);
+    node->recountChunk();
+
+    auto right = merge(std::move(tail), std::move(node->right));
+    node->update();
+    return {std::move(node), std::move(right)};
+}
+
+Rope::NodePtr Rope::merge(NodePtr left, NodePtr right) {
+    if (!left)
+        return right;
+    if (!right)
+        return left;
+
+    if (left->priority > right->priority) {
+        left->right = merge(std::move(left->right), std::move(right));
+        left->update();
+        return left;
+    }
+
+    right->left = merge(std::move(left), std::move(right->left));
+    right->update();
+    return right;
+}
+
+bool Rope::insertInPlace(Node *node, Size pos, std::string_view text) {
+    if (!node)
+        return false;
+
+    const auto leftBytes = BytesOf(node->left);
+    const auto chunkEnd = leftBytes + node->chunk.size();
+    bool inserted = false;
+
+    if (pos < leftBytes)
+        inserted = insertInPlace(node->left.get(), pos, text);
+    else if (pos > chunkEnd)
+        inserted = insertInPlace(node->right.get(), pos - chunkEnd, text);
+    else if (node->chunk.size() + text.size() <= ChunkSize) {
+        node->chunk.insert(pos - leftBytes, text);
+        node->chunkNewlines += std::count(text.begin(), text.end(), '\n');
+        inserted = true;
+    }
+
+    if (inserted)
+        node->update();
+
+    return inserted;
+}
+
+Rope::Size Rope::size() const {
+    return BytesOf(_root);
+}
+
+bool Rope::empty() const {
+    return size() == 0;
+}
+
+Rope::Size Rope::lineCount() const {
+    return NewlinesOf(_root) + 1;
+}
+
+void Rope::clear() {
+    _root.reset();
+}
+
+void Rope::assign(std::string_view text) {
+    _root = build(text);
+}
+
+void Rope::append(std::string_view text) {
+    insert(size(), text);
+}
+
+void Rope::insert(Size pos, std::string_view text) {
+    if (text.empty())
+        return;
+
+    pos = std::min(pos, size());
+    if (insertInPlace(_root.get(), pos, text))
+        return;
+
+    auto [left, right] = split(std::move(_root), pos);
+    _root = merge(merge(std::move(left), build(text)), std::move(right));
+}
+
+void Rope::erase(Size pos, Size count) {
+    if (pos >= size() || count == 0)
+        return;
+
+    auto [left, rest] = split(std::move(_root), pos);
+    auto [erased, right] = split(std::move(rest), count);
+    _root = merge(std::move(left), std::move(right));
+}
+
+Rope::Size Rope::lineStart(Size line) const {
+    if (line == 0)
+        return 0;
+
+    if (line > NewlinesOf(_root))
+        return size();
+
+    // look for the `line`-th newline, next line begins right after it
+    Size remaining = line;
+    Size offset = 0;
+    const Node *node = _root.get();
+
+    while (node) {
+        const auto leftNewlines = NewlinesOf(node->left);
+
+        if (remaining <= leftNewlines) {
+            node = node->left.get();
+            continue;
+        }
+
+        remaining -= leftNewlines;
+        offset += BytesOf(node->left);
+
+        if (remaining <= node->chunkNewlines) {
+            Size index = 0;
+            for (; index < node->chunk.size(); ++index) {
+                if (node->chunk[index] == '\n' && --remaining == 0)
+                    break;
+            }
+            return offset + index + 1;
+        }
+
+        remaining -= node->chunkNewlines;
+        offset += node->chunk.size();
+        node = node->right.get();
+    }
+
+    return size();
+}
+
+Rope::Size Rope::lineOf(Size pos) const {
+    Size line = 0;
+    const Node *node = _root.get();
+
+    while (node) {
+        const auto leftBytes = BytesOf(node->left);
+
+        if (pos < leftBytes) {
+            node = node->left.get();
+            continue;
+        }
+
+        line += NewlinesOf(node->left);
+        pos -= leftBytes;
+
+        if (pos < node->chunk.size()) {
+            line += std::count(node->chunk.begin(), node->chunk.begin() + pos, '\n');
+            break;
+        }
+
+        line += node->chunkNewlines;
+        pos -= node->chunk.size();
+        node = node->right.get();
+    }
+
+    return line;
+}
+
+std::string Rope::line(Size line) const {
+    const auto start = lineStart(line);
+    auto end = lineStart(line + 1);
+
+    // strip trailing newline
+    if (end > start && line < NewlinesOf(_root))
+        --end;
+
+    return substr(start, end - start);
+}
+
+void Rope::collect(const Node *node, Size nodeStart, Size from, Size to, std::string &output) const {
+    if (!node || from >= to)
+        return;
+
+    const auto chunkStart = nodeStart + BytesOf(node->left);
+    const auto chunkEnd = chunkStart + node->chunk.size();
+
+    if (from < chunkStart)
+        collect(node->left.get(), nodeStart, from, to, output);
+
+    if (from < chunkEnd && to > chunkStart) {
+        const auto begin = std::max(from, chunkStart) - chunkStart;
+        const auto end = std::min(to, chunkEnd) - chunkStart;
+        output.append(node->chunk, begin, end - begin);
+    }
+
+    if (to > chunkEnd)
+        collect(node->right.get(), chunkEnd, from, to, output);
+}
+
+std::string Rope::substr(Size pos, Size count) const {
+    std::string output;
+    const auto end = std::min(size(), pos + std::min(count, size()));
+    if (pos >= end)
+        return output;
+
+    output.reserve(end - pos);
+    collect(_root.get(), 0, pos, end, output);
+    return output;
+}
+
+std::string Rope::toString() const {
+    return substr(0, size());
+}
+
+} // namespace text
+} // namespace ui
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace ui {
+namespace text {
+
+/**
+ * Text storage for large documents.
+ *
+ * Bytes are kept in bounded chunks stored as nodes of an implicit treap ordered by
+ * byte offset. Every node caches the byte and newline count of its subtree which acts
+ * as the line index : insertion, removal, offset <-> line lookups are O(log n)
+ * and appending to the last chunk is done in place.
+ */
+class Rope {
+  public:
+    using Size = std::size_t;
+
+    // Chunks are split once they grow past this amount of bytes
+    static constexpr Size ChunkSize = 1024;
+
+  private:
+    struct Node {
+        std::string chunk;
+        std::uint32_t priority;
+        Size chunkNewlines;
+        Size bytes;    // whole subtree
+        Size newlines; // whole subtree
+        std::unique_ptr<Node> left;
+        std::unique_ptr<Node> right;
+
+        Node(std::string_view text, std::uint32_t priority);
+
+        void recountChunk();
+        void update();
+    };
+
+    using NodePtr = std::unique_ptr<Node>;
+
+    NodePtr _root;
+    std::minstd_rand _rng;
+
+    static Size BytesOf(const NodePtr &node);
+    static Size NewlinesOf(const NodePtr &node);
+
+    NodePtr makeNode(std::string_view text);
+
+    // Build a subtree out of `text` cut into chunks
+    NodePtr build(std::string_view text);
+
+    // Left part holds the first `pos` bytes
+    std::pair<NodePtr, NodePtr> split(NodePtr node, Size pos);
+    NodePtr merge(NodePtr left, NodePtr right);
+
+    // Insert inside an existing chunk if it has room for it
+    // @return `false` if no chunk could receive `text`
+    bool insertInPlace(Node *node, Size pos, std::string_view text);
+
+    void collect(const Node *node, Size nodeStart, Size from, Size to, std::string &output) const;
+
+  public:
+    Rope();
+    Rope(std::string_view text);
+
+    Rope(Rope &&) = default;
+    Rope &operator=(Rope &&) = default;
+
+    // Byte count
+    Size size() const;
+    bool empty() const;
+
+    // An empty rope still has one (empty) line
+    Size lineCount() const;
+
+    void clear();
+    void assign(std::string_view text);
+    void append(std::string_view text);
+    void insert(Size pos, std::string_view text);
+    void erase(Size pos, Size count);
+
+    // Byte offset of the first character of `line`, `size()` if out of range
+    Size lineStart(Size line) const;
+
+    // Index of the line containing byte `pos`
+    Size lineOf(Size pos) const;
+
+    // Content of `line` without its trailing newline
+    std::string line(Size line) const;
+
+    std::string substr(Size pos, Size count) const;
+    std::string toString() const;
+};
+
+} // namespace text
+} // namespace ui
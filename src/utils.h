@@ -1,5 +1,6 @@
 #pragma once
 
+#include "./utils/containers.h"
 #include "./utils/debug.h"
 #include "./utils/functions.h"
 #include "./utils/operators.h"
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace utils {
+
+/**
+ * Sequence storing its first `N` items inline, spilling to the heap past that.
+ * Meant for short-lived small collections built on hot paths (event paths, ...).
+ */
+template <typename T, std::size_t N>
+class InlineVector {
+    std::array<T, N> _inline;
+    std::vector<T> _overflow;
+    std::size_t _size = 0;
+
+  public:
+    InlineVector() = default;
+
+    void push_back(const T &item) {
+        if (_size < N)
+            _inline[_size] = item;
+        else
+            _overflow.push_back(item);
+        ++_size;
+    }
+
+    T &operator[](std::size_t index) {
+        return index < N ? _inline[index] : _overflow[index - N];
+    }
+
+    const T &operator[](std::size_t index) const {
+        return index < N ? _inline[index] : _overflow[index - N];
+    }
+
+    T &back() {
+        return (*this)[_size - 1];
+    }
+
+    std::size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    void clear() {
+        for (std::size_t i = 0; i < _size && i < N; ++i)
+            _inline[i] = T{};
+        _overflow.clear();
+        _size = 0;
+    }
+};
+
+} // namespace utils
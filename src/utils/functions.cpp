@@ -57,38 +57,25 @@ Vector2 transformPoint(const Vector2 &point,
     return transformed;
 }
 
-void drawRectangle(const Rectangle &rect,
-                   float top,
-                   float bottom,
-                   float left,
-                   float right,
-                   const Color &topColor,
-                   const Color &bottomColor,
-                   const Color &leftColor,
-                   const Color &rightColor) {
-    auto divBy2 = [](float num) { return num <= 1.0 ? num : (num / 2); };
-
-    if (top > 0.0 && topColor.a > 0)
-        DrawLineEx(Vector2{.x = rect.x, .y = rect.y + divBy2(top)},
-                   Vector2{.x = rect.x + rect.width, .y = rect.y + divBy2(top)},
-                   top, topColor);
-
-    if (left > 0.0 && leftColor.a > 0)
-        DrawLineEx(Vector2{.x = rect.x + divBy2(left), .y = rect.y},
-                   Vector2{.x = rect.x + divBy2(left), .y = rect.y + rect.height},
-                   left, leftColor);
-
-    if (bottom > 0.0 && bottomColor.a > 0)
-        DrawLineEx(Vector2{.x = rect.x, .y = rect.y + rect.height - divBy2(bottom)},
-                   Vector2{.x = rect.x + rect.width,
-                           .y = rect.y + rect.height - divBy2(bottom)},
-                   bottom, bottomColor);
+Vector2 inverseTransformPoint(const Vector2 &point,
+                              const Vector2 &origin,
+                              float rotation,
+                              const Vector2 &scale,
+                              const Vector2 &translation) {
+    // Translate
+    const float x = point.x - translation.x - origin.x;
+    const float y = point.y - translation.y - origin.y;
 
-    if (right > 0.0 && rightColor.a > 0)
-        DrawLineEx(Vector2{.x = rect.x + rect.width - divBy2(right), .y = rect.y},
-                   Vector2{.x = rect.x + rect.width - divBy2(right),
-                           .y = rect.y + rect.height},
-                   right, rightColor);
+    // Rotate
+    const float cosR = std::cos(rotation);
+    const float sinR = std::sin(rotation);
+    const float rx = cosR * x + sinR * y;
+    const float ry = -sinR * x + cosR * y;
+
+    // Scale, degenerate axes map everything onto origin
+    return Vector2{
+        .x = (scale.x != 0 ? rx / scale.x : 0) + origin.x,
+        .y = (scale.y != 0 ? ry / scale.y : 0) + origin.y};
 }
 
 float clampRatio(float ratio) {
@@ -20,15 +20,11 @@ Vector2 transformPoint(const Vector2 &point,
                        const Vector2 &scale,
                        const Vector2 &translation);
 
-// Draw rectangle by drawing four edges individualy
-void drawRectangle(const Rectangle &rect,
-                   float top,
-                   float bottom,
-                   float left,
-                   float right,
-                   const Color &topColor,
-                   const Color &bottomColor,
-                   const Color &leftColor,
-                   const Color &rightColor);
+// Point which scaled, rotated around `origin` then translated gives `point`
+Vector2 inverseTransformPoint(const Vector2 &point,
+                              const Vector2 &origin,
+                              float rotation,
+                              const Vector2 &scale,
+                              const Vector2 &translation);
 
 } // namespace utils
\ No newline at end of file
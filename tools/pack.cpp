@@ -0,0 +1,52 @@
+#include <bundle.h>
+
+#include <raylib.h>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+bool isFont(const fs::path &path) {
+    auto extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+    return extension == ".ttf" || extension == ".otf";
+}
+
+} // namespace
+
+// RetainedUI_pack <output.bundle> [name=]file ...
+// Fonts (.ttf, .otf) are rasterized, anything else is decoded as an image. Assets are named after
+// their path as given unless a name is provided : it must match what repositories are asked to load,
+// e.g. `Image` source paths. Run from repository root :
+// ./build/bin/RetainedUI_pack assets.bundle assets/images/cat.png Roboto-Regular.ttf=assets/fonts/Roboto-Regular.ttf
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::cerr << "usage : " << argv[0] << " <output.bundle> [name=]file ..." << std::endl;
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    bundle::BundleWriter writer;
+    bool success = true;
+
+    for (int i = 2; i < argc; ++i) {
+        const std::string argument(argv[i]);
+        const auto separator = argument.find('=');
+        const auto name = separator == std::string::npos ? fs::path(argument).generic_string() : argument.substr(0, separator);
+        const fs::path path = separator == std::string::npos ? argument : argument.substr(separator + 1);
+
+        success &= isFont(path) ? writer.addFontFile(name, path) : writer.addTextureFile(name, path);
+    }
+
+    if (!success || !writer.write(argv[1]))
+        return 1;
+
+    std::cerr << "[pack] " << writer.getEntryCount() << " assets written to " << argv[1] << std::endl;
+    return 0;
+}